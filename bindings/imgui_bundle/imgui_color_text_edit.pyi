@@ -497,4 +497,65 @@ class TextEditor:
         pass
 ####################    </generated_from:TextEditor.h>    ####################
 
+
+####################    <generated_from:TextEditorChangeTracker.h>    ####################
+
+
+class TextEditorDelta:
+    """ TextEditorDelta: an edit between two versions of the text:
+     the lines [StartLine, EndLine) of the previous version were replaced by InsertedLines
+    """
+    version: int = 0  # Version of the text after this edit
+    start_line: int = 0
+    end_line: int = 0
+    inserted_lines: List[str]
+    def __init__(
+        self,
+        version: int = 0,
+        start_line: int = 0,
+        end_line: int = 0,
+        inserted_lines: List[str] = List[str]()
+        ) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+
+####################    </generated_from:TextEditorChangeTracker.h>    ####################
+
 # </litgen_stub> // Autogenerated code end!
+
+
+####################    TextEditorChangeTracker (bound manually: the tracker keeps its editor alive)    ####################
+
+class TextEditorChangeTracker:
+    """ TextEditorChangeTracker: a version counter for the text of a TextEditor, and the deltas between versions.
+
+     Call Update() once per frame, after TextEditor::Render(): when the text did not change, it only queries
+     the editor flags and hashes the text (one GetText() copy, which detects a SetText() between two frames).
+     When it did, the new lines are compared to the previous ones, and the changed range is recorded as a delta.
+     Note: this comparison is O(file size) for each frame with an edit (all the lines are copied with
+     GetTextLines(), and the tracker keeps its own copy of them): the tracker saves the consumer's work
+     (it receives the changed lines only), not the editor side work.
+     This lets a consumer sync with the editor incrementally, instead of processing the whole text at each frame.
+    """
+    def __init__(self, editor: TextEditor, max_deltas: int = 256) -> None:
+        """The editor must outlive the tracker (in python, the tracker keeps the editor alive)"""
+        pass
+
+    def update(self) -> bool:
+        """Returns True if the text changed since the last call"""
+        pass
+
+    def get_version(self) -> int:
+        """The version starts at 0, and is incremented at each change"""
+        pass
+
+    def get_oldest_available_version(self) -> int:
+        """Deltas older than this version were discarded (only maxDeltas deltas are kept)"""
+        pass
+
+    def get_deltas_since(self, since_version: int) -> List[TextEditorDelta]:
+        """ Returns the deltas since sinceVersion, oldest first.
+         If sinceVersion < GetOldestAvailableVersion(), some deltas are missing: resync with TextEditor::GetText() instead.
+        """
+        pass
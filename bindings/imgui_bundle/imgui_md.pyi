@@ -25,6 +25,17 @@ class MarkdownFontOptions:
     max_header_level: int = 2
     size_diff_between_levels: float = 2.0
     regular_size: float = 16.0
+
+    # If scaleHeaderFonts is True, only one header font (at the largest header size) is loaded
+    # per emphasis variant, and the smaller header levels are rendered by scaling it down.
+    # This keeps the font atlas small when maxHeaderLevel is large
+    # (at the cost of slightly less crisp small headers).
+    scale_header_fonts: bool = False
+
+    # If lazyLoadRareFonts is True, the rarely used font variants (bold italic text, bold or italic headers)
+    # are loaded only when a document first uses them, at the next frame boundary (HelloImGui only).
+    # Until then, the same text with less emphasis is displayed. This keeps the font atlas smaller.
+    lazy_load_rare_fonts: bool = False
     def __init__(self) -> None:
         """Autogenerated default constructor"""
         pass
@@ -85,6 +96,42 @@ class MarkdownCallbacks:
 class MarkdownOptions:
     font_options: MarkdownFontOptions
     callbacks: MarkdownCallbacks
+
+    # If withBlockCache is True, Render() splits each markdown string into its top-level blocks
+    # (paragraphs, lists, tables, code blocks...) once, and remembers the height of each block:
+    # only the visible blocks are rendered, the others are replaced by an empty space (so that a long document scrolls as fast as a short one).
+    # All the blocks are rendered again when the available width or the font size change, in order to measure them.
+    # (html blocks such as divs are never split, so that OnHtmlDiv calls stay paired, and neither are loose lists)
+    with_block_cache: bool = False
+
+    # The images displayed by OnImage_Default are read and decoded by a worker thread
+    # (a placeholder of the right size is displayed in the meantime).
+    # Their textures (and the decoded images which wait for their upload) are kept in a cache whose memory
+    # is limited to imageCacheBudgetMB: when it is exceeded, the least recently displayed images are evicted,
+    # except those displayed during the last 60 frames.
+    image_cache_budget_mb: int = 256
+    def __init__(self) -> None:
+        """Autogenerated default constructor"""
+        pass
+
+class MarkdownImageCacheStats:
+    """Statistics of the image cache used by OnImage_Default"""
+
+    # Number of textures in the cache
+    nb_textures: int = 0
+    # Memory used by these textures
+    texture_bytes: int = 0
+    budget_bytes: int = 0
+    # Images being read and decoded
+    nb_pending_images: int = 0
+    # Memory used by the decoded images which wait for their upload (counts toward the budget)
+    decoded_bytes: int = 0
+    # Total number of images uploaded as textures
+    nb_uploaded_images: int = 0
+    # Total number of images evicted from the cache
+    nb_evicted_images: int = 0
+    # Images which could not be read or decoded
+    nb_failed_images: int = 0
     def __init__(self) -> None:
         """Autogenerated default constructor"""
         pass
@@ -108,12 +155,27 @@ def initialize_markdown(options: MarkdownOptions = MarkdownOptions()) -> None:
     pass
 
 def de_initialize_markdown() -> None:
+    """DeInitializeMarkdown: destroys the renderer and the textures of its images:
+    call it while OpenGL is still initialized (e.g. in callbacks.BeforeExit). ImmApp::Run does this automatically.
+    """
     pass
 
 def get_font_loader_function() -> VoidFunction:
     """GetFontLoaderFunction() will return a function that you should call during ImGui initialization."""
     pass
 
+def enable_lazy_font_loading() -> None:
+    """EnableLazyFontLoading: (HelloImGui only) instead of loading the fonts at startup via GetFontLoaderFunction(),
+    you may call this after InitializeMarkdown(): the fonts will then be loaded at the next frame boundary
+    after the first call to Render() or GetCodeFont().
+    Until the fonts are loaded, Render() displays nothing and GetCodeFont() returns None.
+    """
+    pass
+
+def are_fonts_loaded() -> bool:
+    """AreFontsLoaded returns True once the markdown fonts are loaded"""
+    pass
+
 def render(markdown_string: str) -> None:
     """Renders a markdown string"""
     pass
@@ -125,6 +187,33 @@ def render_unindented(markdown_string: str) -> None:
 def get_code_font() -> ImFont:
     pass
 
+def get_image_cache_stats() -> MarkdownImageCacheStats:
+    """GetImageCacheStats: statistics of the image cache used by OnImage_Default (see MarkdownOptions.imageCacheBudgetMB)"""
+    pass
+
+class MarkdownStream:
+    """ MarkdownStream: renders a markdown text which grows over time (job reports, streamed outputs, logs...)
+     Calling Render() on an ever-longer string costs O(total length) at each frame. Instead, Append() only scans
+     the new text from the last block boundary, and Render() reuses the heights of the completed blocks:
+     only the visible blocks and the last block (which may still grow) are rendered.
+     (the text is split into blocks as with MarkdownOptions.withBlockCache)
+    """
+    def __init__(self) -> None:
+        pass
+
+    def append(self, text: str) -> None:
+        """Appends some markdown text (which may end in the middle of a line)"""
+        pass
+    def clear(self) -> None:
+        """Removes all the text"""
+        pass
+    def get_text(self) -> str:
+        pass
+
+    def render(self) -> None:
+        """Renders the text (InitializeMarkdown must have been called, as for Render)"""
+        pass
+
 ####################    </generated_from:imgui_md_wrapper.h>    ####################
 
 # </litgen_stub> // Autogenerated code end!
@@ -3,6 +3,41 @@ from imgui_bundle._imgui_bundle import immapp_cpp as immapp_cpp  # type: ignore
 from imgui_bundle._imgui_bundle.immapp_cpp import (  # type: ignore
     clock_seconds,
 
+    FramePhase,
+    FramePhaseStats,
+    frame_phase_name,
+    get_frame_timings_stats,
+    get_frame_timings_history,
+    get_frame_timings_nb_recorded_frames,
+    clear_frame_timings,
+    show_frame_timings_window,
+
+    request_redraw,
+    request_redraw_at,
+    request_redraw_in,
+
+    StartupPhase,
+    StartupTimeline,
+    get_startup_timeline,
+    startup_timeline_to_chrome_trace,
+    save_startup_timeline_chrome_trace,
+
+    FontAtlasCacheStats,
+    install_font_atlas_cache,
+    font_atlas_cache_folder,
+    delete_font_atlas_cache,
+    get_font_atlas_cache_stats,
+
+    install_parallel_font_builder,
+
+    DynamicGlyphsStats,
+    load_font_with_dynamic_glyphs,
+    request_glyphs,
+    get_dynamic_glyphs_stats,
+
+    install_async_font_rebuild,
+    is_font_rebuild_pending,
+
     default_node_editor_context,
     default_node_editor_config,
 
@@ -17,7 +52,9 @@ from imgui_bundle._imgui_bundle.immapp_cpp import (  # type: ignore
 
     run,
     run_with_markdown,
+    run_with_null_backend,
     AddOnsParams,
+    NullBackendParams,
     snippets,
 
     begin_plot_in_node_editor,
@@ -48,6 +85,34 @@ from imgui_bundle._imgui_bundle.hello_imgui import (  # type: ignore
 
 __all__ = [
     "clock_seconds",
+    "FramePhase",
+    "FramePhaseStats",
+    "frame_phase_name",
+    "get_frame_timings_stats",
+    "get_frame_timings_history",
+    "get_frame_timings_nb_recorded_frames",
+    "clear_frame_timings",
+    "show_frame_timings_window",
+    "request_redraw",
+    "request_redraw_at",
+    "request_redraw_in",
+    "StartupPhase",
+    "StartupTimeline",
+    "get_startup_timeline",
+    "startup_timeline_to_chrome_trace",
+    "save_startup_timeline_chrome_trace",
+    "FontAtlasCacheStats",
+    "install_font_atlas_cache",
+    "font_atlas_cache_folder",
+    "delete_font_atlas_cache",
+    "get_font_atlas_cache_stats",
+    "install_parallel_font_builder",
+    "DynamicGlyphsStats",
+    "load_font_with_dynamic_glyphs",
+    "request_glyphs",
+    "get_dynamic_glyphs_stats",
+    "install_async_font_rebuild",
+    "is_font_rebuild_pending",
     "default_node_editor_context",
     "default_node_editor_config",
     "delete_node_editor_settings",
@@ -59,7 +124,9 @@ __all__ = [
     "pixel_size_to_em",
     "run",
     "run_with_markdown",
+    "run_with_null_backend",
     "AddOnsParams",
+    "NullBackendParams",
     "icons_fontawesome",  # v4
     "icons_fontawesome_4",
     "icons_fontawesome_6",
@@ -1,6 +1,34 @@
 from . import immapp_cpp as immapp_cpp
 from .immapp_cpp import (
     clock_seconds as clock_seconds,
+    FramePhase as FramePhase,
+    FramePhaseStats as FramePhaseStats,
+    frame_phase_name as frame_phase_name,
+    get_frame_timings_stats as get_frame_timings_stats,
+    get_frame_timings_history as get_frame_timings_history,
+    get_frame_timings_nb_recorded_frames as get_frame_timings_nb_recorded_frames,
+    clear_frame_timings as clear_frame_timings,
+    show_frame_timings_window as show_frame_timings_window,
+    request_redraw as request_redraw,
+    request_redraw_at as request_redraw_at,
+    request_redraw_in as request_redraw_in,
+    StartupPhase as StartupPhase,
+    StartupTimeline as StartupTimeline,
+    get_startup_timeline as get_startup_timeline,
+    startup_timeline_to_chrome_trace as startup_timeline_to_chrome_trace,
+    save_startup_timeline_chrome_trace as save_startup_timeline_chrome_trace,
+    FontAtlasCacheStats as FontAtlasCacheStats,
+    install_font_atlas_cache as install_font_atlas_cache,
+    font_atlas_cache_folder as font_atlas_cache_folder,
+    delete_font_atlas_cache as delete_font_atlas_cache,
+    get_font_atlas_cache_stats as get_font_atlas_cache_stats,
+    install_parallel_font_builder as install_parallel_font_builder,
+    DynamicGlyphsStats as DynamicGlyphsStats,
+    load_font_with_dynamic_glyphs as load_font_with_dynamic_glyphs,
+    request_glyphs as request_glyphs,
+    get_dynamic_glyphs_stats as get_dynamic_glyphs_stats,
+    install_async_font_rebuild as install_async_font_rebuild,
+    is_font_rebuild_pending as is_font_rebuild_pending,
     default_node_editor_context as default_node_editor_context,
     em_size as em_size,
     em_to_vec2 as em_to_vec2,
@@ -8,7 +36,9 @@ from .immapp_cpp import (
     pixel_size_to_em as pixel_size_to_em,
     run as run,
     run_with_markdown as run_with_markdown,
+    run_with_null_backend as run_with_null_backend,
     AddOnsParams as AddOnsParams,
+    NullBackendParams as NullBackendParams,
     snippets as snippets,
     begin_plot_in_node_editor as begin_plot_in_node_editor,
     end_plot_in_node_editor as end_plot_in_node_editor,
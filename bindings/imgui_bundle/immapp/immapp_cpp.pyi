@@ -5,6 +5,7 @@
 from typing import Tuple, Optional, Callable, List, overload, Any
 import enum
 from imgui_bundle import imgui_md, hello_imgui, ImVec2
+from imgui_bundle.imgui import ImFont
 from imgui_bundle.imgui_node_editor import (
     Config as NodeEditorConfig,
     EditorContext as NodeEditorContext,
@@ -121,6 +122,32 @@ class AddOnsParams:
 
     # You can tweak MarkdownOptions (but this is optional)
     with_markdown_options: Optional[ImGuiMd.MarkdownOptions] = None
+
+    # Set withFrameTimings=True to record the time spent in each phase of the frames
+    # (see frame_timings.h: GetFrameTimingsStats(), ShowFrameTimingsWindow())
+    with_frame_timings: bool = False
+
+    # Set withLazyInit=True to initialize the addons on first use, instead of at startup:
+    #   - the markdown fonts are loaded at the next frame boundary after the first call to ImGuiMd::Render()
+    #     (nothing is displayed during that frame)
+    #   - the node editor context is created by the first call to DefaultNodeEditorContext()
+    #     (call it before using ax::NodeEditor)
+    # This reduces the startup time of apps which do not always use these addons.
+    # (ImPlot and ImGuiTexInspect contexts are cheap to create, and are still created at startup)
+    with_lazy_init: bool = False
+
+    # Set withFontAtlasCache=True to save the baked font atlas to disk, and reload it at the next launches
+    # instead of rasterizing the fonts again (see font_atlas_cache.h)
+    with_font_atlas_cache: bool = False
+
+    # Set withParallelFontBuild=True to rasterize the independent fonts on several threads
+    # when the font atlas is built (see font_atlas_parallel_build.h)
+    with_parallel_font_build: bool = False
+
+    # Set withAsyncFontRebuild=True to rebuild the font atlas on a worker thread when the fonts
+    # are reloaded after startup (e.g. after a DPI change), instead of freezing the UI
+    # (see font_atlas_async_rebuild.h)
+    with_async_font_rebuild: bool = False
     def __init__(
         self,
         with_implot: bool = False,
@@ -129,6 +156,11 @@ class AddOnsParams:
         with_tex_inspect: bool = False,
         with_node_editor_config: Optional[NodeEditorConfig] = None,
         with_markdown_options: Optional[ImGuiMd.MarkdownOptions] = None,
+        with_frame_timings: bool = False,
+        with_lazy_init: bool = False,
+        with_font_atlas_cache: bool = False,
+        with_parallel_font_build: bool = False,
+        with_async_font_rebuild: bool = False,
     ) -> None:
         """Auto-generated default constructor with named params"""
         pass
@@ -208,6 +240,36 @@ def run_with_markdown(
     """Run an application with markdown"""
     pass
 
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Headless runs, with HelloImGui's Null backend (no window, no GPU)
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+class NullBackendParams:
+    # Number of frames to render before exiting
+    # (if 0, the app will run until runnerParams.appShallExit is set to True)
+    nb_frames: int = 60
+
+    # Fixed time step (in seconds) given to ImGui at each frame
+    fixed_delta_time: float = 1.0 / 60.0
+    def __init__(self, nb_frames: int = 60, fixed_delta_time: float = 1.0 / 60.0) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def run_with_null_backend(
+    runner_params: HelloImGui.RunnerParams,
+    add_ons_params: AddOnsParams = AddOnsParams(),
+    null_backend_params: NullBackendParams = NullBackendParams(),
+) -> None:
+    """RunWithNullBackend: runs an application with the Null platform and renderer backends.
+    NewFrame/Render are called at each frame, and the resulting ImDrawData is discarded.
+    All the RunnerCallbacks are called, and the addons are initialized as with Run().
+    This is useful to measure the CPU cost of your gui functions, on machines without display or GPU
+    (e.g. CI servers).
+    The backends, idling and callbacks of runnerParams are restored after the run: they can be reused for another run.
+    """
+    pass
+
 # ///////////////////////////////////////////////////////////////////////////////////////
 #
 # Dpi aware utilities (which call the same utilities from HelloImGui)
@@ -284,6 +346,366 @@ def clock_seconds() -> float:
 
 ####################    </generated_from:clock.h>    ####################
 
+####################    <generated_from:frame_timings.h>    ####################
+
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Frame timings: per phase breakdown of the time spent in each frame
+#
+# Enable it with AddOnsParams.withFrameTimings = True. ImmApp::Run will then time
+# each phase of the runner loop, and store the results in a ring buffer
+# (the writer is the main thread and never blocks, readers may be on any thread).
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+
+class FramePhase(enum.Enum):
+    # callbacks.PreNewFrame
+    pre_new_frame = enum.auto()  # (= 0)
+    # callbacks.ShowGui (excluding the dockable windows)
+    show_gui = enum.auto()  # (= 1)
+    # The GuiFunction of all the dockable windows
+    dockable_windows = enum.auto()  # (= 2)
+    # callbacks.CustomBackground
+    custom_background = enum.auto()  # (= 3)
+    # callbacks.BeforeImGuiRender
+    before_imgui_render = enum.auto()  # (= 4)
+    # ImGui::Render + backend rendering + swap buffers (inferred from the surrounding callbacks)
+    render_and_swap = enum.auto()  # (= 5)
+    # callbacks.AfterSwap
+    after_swap = enum.auto()  # (= 6)
+    # Events polling + idle sleep (time between AfterSwap and the next PreNewFrame)
+    idle = enum.auto()  # (= 7)
+
+    count = enum.auto()  # (= 8)
+
+def frame_phase_name(phase: FramePhase) -> str:
+    """FramePhaseName returns a displayable name for a phase"""
+    pass
+
+class FramePhaseStats:
+    """Statistics for a phase, computed on the frames stored in the ring buffer (all durations in milliseconds)"""
+
+    phase: FramePhase = FramePhase.pre_new_frame
+    p50_ms: float = 0.0
+    p95_ms: float = 0.0
+    p99_ms: float = 0.0
+    mean_ms: float = 0.0
+    max_ms: float = 0.0
+    def __init__(
+        self,
+        phase: FramePhase = FramePhase.pre_new_frame,
+        p50_ms: float = 0.0,
+        p95_ms: float = 0.0,
+        p99_ms: float = 0.0,
+        mean_ms: float = 0.0,
+        max_ms: float = 0.0,
+    ) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def get_frame_timings_stats() -> List[FramePhaseStats]:
+    """GetFrameTimingsStats returns the statistics for each phase (in the order of FramePhase)
+    (returns an empty vector if no frame was recorded)
+    """
+    pass
+
+def get_frame_timings_history(phase: FramePhase) -> List[float]:
+    """GetFrameTimingsHistory returns the durations (in ms) of a phase, for the recorded frames (oldest first)"""
+    pass
+
+def get_frame_timings_nb_recorded_frames() -> int:
+    """GetFrameTimingsNbRecordedFrames returns the total number of recorded frames since the app start
+    (the ring buffer only keeps the last FrameTimingsCapacity() frames)
+    """
+    pass
+
+def frame_timings_capacity() -> int:
+    pass
+
+def clear_frame_timings() -> None:
+    """ClearFrameTimings clears the ring buffer"""
+    pass
+
+def show_frame_timings_window(p_open: Optional[bool] = None) -> Optional[bool]:
+    """ShowFrameTimingsWindow: displays a window with p50/p95/p99 per phase,
+    and a plot of the recent history (if ImPlot is available)
+    """
+    pass
+
+####################    </generated_from:frame_timings.h>    ####################
+
+####################    <generated_from:redraw.h>    ####################
+
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Redraw requests: wake up an idling application
+#
+# When idling (see HelloImGui::FpsIdling), the application waits for user events,
+# and only renders fpsIdle frames per second. Instead of raising fpsIdle, widgets
+# and worker threads can request exactly the frames they need:
+#     - RequestRedraw(): render a new frame as soon as possible
+#     - RequestRedrawAt(t): render a new frame at time t (as given by ImmApp::ClockSeconds())
+# With this, fpsIdle can be set to a low value (e.g. 1), while keeping live data up to date.
+#
+# These functions can be called from any thread. They do nothing if no application is running.
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+
+def request_redraw() -> None:
+    """RequestRedraw: wakes up the application, so that a new frame is rendered as soon as possible."""
+    pass
+
+def request_redraw_at(time_seconds: float) -> None:
+    """RequestRedrawAt: requests that a new frame be rendered at the given time
+    (timeSeconds is given in the same unit/origin as ImmApp::ClockSeconds()).
+    """
+    pass
+
+def request_redraw_in(delay_seconds: float) -> None:
+    """RequestRedrawIn: requests that a new frame be rendered after delaySeconds"""
+    pass
+
+####################    </generated_from:redraw.h>    ####################
+
+####################    <generated_from:startup_timeline.h>    ####################
+
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Startup timeline: where does the time go between ImmApp::Run() and the first displayed frame?
+#
+# ImmApp::Run records the startup phases delimited by the HelloImGui callbacks
+# (SetupImGuiConfig, SetupImGuiStyle, LoadAdditionalFonts, PostInit, first frame).
+# The time spent inside HelloImGui between two callbacks (window creation, GL loader,
+# font atlas build, ini parsing, ...) is reported as "HelloImGui (before <next phase>)".
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+
+class StartupPhase:
+    name: str
+    # Start time, relative to the start of ImmApp::Run (in seconds)
+    start_seconds: float = 0.0
+    # Wall clock duration (in seconds)
+    wall_seconds: float = 0.0
+    # CPU time used by the process (all threads) during this phase (in seconds)
+    cpu_seconds: float = 0.0
+    def __init__(
+        self,
+        name: str = "",
+        start_seconds: float = 0.0,
+        wall_seconds: float = 0.0,
+        cpu_seconds: float = 0.0,
+    ) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+class StartupTimeline:
+    phases: List[StartupPhase]
+    total_wall_seconds: float = 0.0
+    total_cpu_seconds: float = 0.0
+    # IsComplete is True once the first frame was displayed
+    is_complete: bool = False
+    def __init__(
+        self,
+        phases: List[StartupPhase] = List[StartupPhase](),
+        total_wall_seconds: float = 0.0,
+        total_cpu_seconds: float = 0.0,
+        is_complete: bool = False,
+    ) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def get_startup_timeline() -> StartupTimeline:
+    """GetStartupTimeline returns the startup timeline of the last call to ImmApp::Run()"""
+    pass
+
+def startup_timeline_to_chrome_trace(timeline: StartupTimeline) -> str:
+    """StartupTimelineToChromeTrace returns the timeline in the Chrome trace event format
+    (can be opened with chrome://tracing, or https://ui.perfetto.dev)
+    """
+    pass
+
+def save_startup_timeline_chrome_trace(filename: str) -> bool:
+    """SaveStartupTimelineChromeTrace saves the current startup timeline as a Chrome trace json file.
+    Returns False in case of failure.
+    """
+    pass
+
+####################    </generated_from:startup_timeline.h>    ####################
+
+####################    <generated_from:font_atlas_cache.h>    ####################
+
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Font atlas disk cache
+#
+# Rasterizing the fonts (especially with the many markdown font variants) is one of the
+# most expensive steps of the application startup. When enabled (AddOnsParams.withFontAtlasCache),
+# the baked atlas (pixels + glyph tables) is saved to disk, and reloaded at the next launches.
+#
+# The cache entry is keyed by a hash of the font files content, sizes (which include the DPI factor),
+# glyph ranges, rasterizer options, ImGui version and glyph layout: any change triggers a rebuild.
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+
+class FontAtlasCacheStats:
+    # Number of atlas builds served from the cache
+    nb_hits: int = 0
+    # Number of atlas builds which required a rasterization
+    nb_misses: int = 0
+    # Duration of the last atlas build (in seconds), whether from the cache or not
+    last_build_seconds: float = 0.0
+    def __init__(self, nb_hits: int = 0, nb_misses: int = 0, last_build_seconds: float = 0.0) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def install_font_atlas_cache(cache_folder: str) -> None:
+    """InstallFontAtlasCache: replaces the font builder of ImGui::GetIO().Fonts by a caching builder
+    which stores its entries in cacheFolder.
+    (ImmApp::Run calls this automatically if AddOnsParams.withFontAtlasCache is True)
+    """
+    pass
+
+def font_atlas_cache_folder(runner_params: HelloImGui.RunnerParams) -> str:
+    """FontAtlasCacheFolder returns the folder where the font atlas cache is stored
+    (next to the ini settings file)
+    """
+    pass
+
+def delete_font_atlas_cache(runner_params: HelloImGui.RunnerParams) -> None:
+    """DeleteFontAtlasCache deletes the font atlas cache folder"""
+    pass
+
+def get_font_atlas_cache_stats() -> FontAtlasCacheStats:
+    pass
+
+####################    </generated_from:font_atlas_cache.h>    ####################
+
+####################    <generated_from:font_atlas_parallel_build.h>    ####################
+
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Parallel font atlas build
+#
+# When enabled (AddOnsParams.withParallelFontBuild), the independent fonts of the atlas
+# (i.e. each font, together with the fonts merged into it) are rasterized concurrently
+# with stb_truetype, each into a private bitmap (the font files are shared, not copied).
+# Their glyphs are then packed into the final atlas in a fixed order, on the main thread,
+# so that the final atlas does not depend on the threads scheduling.
+#
+# With FreeType (which allocates through ImGui, and cannot be used by several threads),
+# the atlas is built serially.
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+
+def install_parallel_font_builder(nb_threads: int = 0) -> None:
+    """InstallParallelFontBuilder: replaces the font builder of ImGui::GetIO().Fonts by a builder
+    which rasterizes the fonts on nbThreads threads (0 = number of hardware threads).
+    (ImmApp::Run calls this automatically if AddOnsParams.withParallelFontBuild is True)
+    """
+    pass
+
+####################    </generated_from:font_atlas_parallel_build.h>    ####################
+
+####################    <generated_from:dynamic_glyphs.h>    ####################
+
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Dynamic glyphs: on demand rasterization for fonts with large glyph ranges (CJK, symbols, ...)
+#
+# Loading such fonts with their full glyph range leads to font atlases of tens of MB,
+# although an application session usually uses a few hundred of their glyphs.
+#
+# A font loaded with LoadFontWithDynamicGlyphs() is first rasterized with its base glyph ranges only.
+# RequestGlyphs(text) queues the glyphs of the text which are missing from the font: they are
+# rasterized in a batch at the next frame boundary (the atlas is rebuilt once, with all the queued glyphs).
+# When a font holds more than maxDynamicGlyphs on demand glyphs, the least recently requested
+# ones are evicted at the next rebuild. The glyphs requested during the current or the previous
+# frame are never evicted: the font may then exceed its budget for a while, and it is brought back
+# to it by a later rebuild (checked every 60 frames), when these glyphs are no longer in use.
+# Atlases with on demand glyphs are not written to the font atlas cache (they change with each batch).
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+
+class DynamicGlyphsStats:
+    # Number of on demand glyphs currently loaded (all fonts)
+    nb_dynamic_glyphs: int = 0
+    # Number of glyphs waiting for the next rebuild
+    nb_pending_glyphs: int = 0
+    # Number of atlas rebuilds triggered by RequestGlyphs
+    nb_rebuilds: int = 0
+    # Number of glyphs evicted since startup
+    nb_evicted_glyphs: int = 0
+    def __init__(
+        self,
+        nb_dynamic_glyphs: int = 0,
+        nb_pending_glyphs: int = 0,
+        nb_rebuilds: int = 0,
+        nb_evicted_glyphs: int = 0,
+    ) -> None:
+        """Auto-generated default constructor with named params"""
+        pass
+
+def load_font_with_dynamic_glyphs(
+    font_filename: str,
+    font_size: float,
+    params: HelloImGui.FontLoadingParams = HelloImGui.FontLoadingParams(),
+    max_dynamic_glyphs: int = 4096,
+) -> ImFont:
+    """LoadFontWithDynamicGlyphs: loads a font whose glyphs will be rasterized on demand
+    (call it inside callbacks.LoadAdditionalFonts).
+      - params.glyphRanges are the base glyph ranges, which are always loaded
+        (if empty, ImGui default ranges are used: Basic Latin + Latin Supplement)
+      - params.useFullGlyphRange and params.mergeFontAwesome are ignored
+    """
+    pass
+
+def request_glyphs(text: str) -> None:
+    """RequestGlyphs: call this with the (utf8) text you are about to display.
+    The glyphs which are missing from the dynamic fonts will be available at the next frame
+    (in the meantime, they are displayed with the fallback glyph).
+    This is cheap when no glyph is missing: it can be called every frame.
+    """
+    pass
+
+def get_dynamic_glyphs_stats() -> DynamicGlyphsStats:
+    pass
+
+####################    </generated_from:dynamic_glyphs.h>    ####################
+
+####################    <generated_from:font_atlas_async_rebuild.h>    ####################
+
+# ///////////////////////////////////////////////////////////////////////////////////////
+#
+# Asynchronous font atlas rebuild
+#
+# When the fonts are reloaded after startup (e.g. FontDpiResponsive fonts, when the window
+# moves to a monitor with a different DPI), rebuilding the atlas synchronously freezes the UI
+# (for hundreds of milliseconds with the markdown fonts).
+#
+# When enabled (AddOnsParams.withAsyncFontRebuild), the glyphs of such rebuilds are rasterized
+# by a worker thread (with stb_truetype). In the meantime, the fonts are displayed with the glyphs
+# of the previous atlas, scaled to their new size. The new glyphs are packed into the atlas
+# at the next frame boundary after the worker is done.
+#
+# The first build (at startup) stays synchronous. A copy of the last built atlas is kept in memory.
+# With FreeType (which allocates through ImGui, and cannot be used outside of the main thread),
+# the rebuilds stay synchronous.
+#
+# /////////////////////////////////////////////////////////////////////////////////////
+
+def install_async_font_rebuild() -> None:
+    """InstallAsyncFontRebuild: replaces the font builder of ImGui::GetIO().Fonts by a builder
+    which rebuilds the atlas asynchronously (the previous builder is used for synchronous builds)
+    (ImmApp::Run calls this automatically if AddOnsParams.withAsyncFontRebuild is True)
+    """
+    pass
+
+def is_font_rebuild_pending() -> bool:
+    """IsFontRebuildPending returns True while the fonts are displayed with a scaled previous atlas"""
+    pass
+
+####################    </generated_from:font_atlas_async_rebuild.h>    ####################
+
 ####################    <generated_from:code_utils.h>    ####################
 
 # <submodule code_utils>
@@ -360,6 +782,13 @@ class snippets:  # Proxy class that introduces typings for the *submodule* snipp
             True  # Keep the code indentation, but remove main indentation,
         )
         # so that the displayed code start at column 1
+
+        virtualized: bool = False  # For very large snippets (logs, generated code...): only the visible lines
+        # are rendered, using a line index. No edition, no cursor position.
+        # Syntax colors are computed by a worker thread while the snippet is displayed (lines are uncolored until then).
+        # The snippet is identified by the ImGui ID stack only (use PushID when several
+        # virtualized snippets share the same scope): when text is appended to its code
+        # (e.g. a log), only the new lines are indexed and colorized.
         def __init__(
             self,
             code: str = "",
@@ -373,6 +802,7 @@ class snippets:  # Proxy class that introduces typings for the *submodule* snipp
             read_only: bool = False,
             border: bool = False,
             de_indent_code: bool = True,
+            virtualized: bool = False,
         ) -> None:
             """Auto-generated default constructor with named params"""
             pass
@@ -381,6 +811,11 @@ class snippets:  # Proxy class that introduces typings for the *submodule* snipp
     def show_code_snippet(
         snippet_data: SnippetData, width: float = 0.0, override_height_in_lines: int = 0
     ) -> None:
+        """ShowCodeSnippet: the editor of a snippet is cached, keyed by a hash of its code (see below).
+        For large codes, this hash only reads a few samples of the code: if the code is modified in place
+        without changing its size, and outside of these samples, the cached editor (or line index, for virtualized snippets) still shows the previous code.
+        Call ClearSnippetCache() after such a modification.
+        """
         pass
 
     @staticmethod
@@ -402,6 +837,43 @@ class snippets:  # Proxy class that introduces typings for the *submodule* snipp
     ) -> None:
         pass
 
+    #
+    # Snippets cache: ShowCodeSnippet keeps an editor per snippet, keyed by a hash of its code
+    # (and of the ImGui ID stack), together with the unindented code and its number of lines.
+    # The hash of a large code is memoized by its address and size, and recomputed when a sample of the code changes:
+    # call ClearSnippetCache() if a large code is modified in place without changing its size.
+    # When the cache is full, the least recently displayed snippets are evicted.
+    #
+    class SnippetCacheStats:
+        nb_entries: int = 0
+        nb_hits: int = 0
+        nb_misses: int = 0
+        nb_evictions: int = 0
+        code_bytes: int = 0  # Total size of the cached code (and of the line indexes and syntax colors of virtualized snippets)
+        def __init__(
+            self,
+            nb_entries: int = 0,
+            nb_hits: int = 0,
+            nb_misses: int = 0,
+            nb_evictions: int = 0,
+            code_bytes: int = 0,
+        ) -> None:
+            """Auto-generated default constructor with named params"""
+            pass
+
+    @staticmethod
+    def get_snippet_cache_stats() -> SnippetCacheStats:
+        pass
+
+    @staticmethod
+    def set_snippet_cache_capacity(capacity: int) -> None:
+        """Default capacity: 256 snippets"""
+        pass
+
+    @staticmethod
+    def clear_snippet_cache() -> None:
+        pass
+
 # </submodule snippets>
 ####################    </generated_from:snippets.h>    ####################
 
@@ -1,8 +1,8 @@
 import enum
 import numpy as np
-from typing import Any, Callable, Tuple, List
+from typing import Any, Callable, Tuple, List, Optional
 
-from imgui_bundle import ImVec4
+from imgui_bundle import ImVec2, ImVec4
 from imgui_bundle.imgui import ImTextureID
 
 
@@ -1225,15 +1225,24 @@ class nvg_imgui:  # Proxy class that introduces typings for the *submodule* nvg_
         nvg_image_flags: int = 0
         # ImTextureID TextureId = {};    /* original C++ signature */
         texture_id: ImTextureID = ImTextureID()
+        # int CapacityWidth = 0,     /* original C++ signature */
+        # Size of the texture, which may be larger than Width x Height after Resize() (OpenGL only)
+        capacity_width: int = 0
+        # CapacityHeight = 0;    /* original C++ signature */
+        # Size of the texture, which may be larger than Width x Height after Resize() (OpenGL only)
+        capacity_height: int = 0
 
         # Warning: this constructor can be called only after a valid renderer backend (OpenGL) has been created
         # (will call Init())
+        # If a pool is given, the allocation may be taken from it, and will be given back to it
+        # (in python, the framebuffer keeps the pool alive)
         # NvgFramebuffer(    /* original C++ signature */
         #             NVGcontext *vg,
         #             int width, int height,
-        #             int nvgImageFlags
+        #             int nvgImageFlags,
+        #             NvgFramebufferPool* pool = nullptr
         #             );
-        def __init__(self, vg: Context, width: int, height: int, nvg_image_flags: int) -> None:
+        def __init__(self, vg: Context, width: int, height: int, nvg_image_flags: int, pool: Optional[NvgFramebufferPool] = None) -> None:
             """ See NVGimageFlags"""
             pass
 
@@ -1248,6 +1257,50 @@ class nvg_imgui:  # Proxy class that introduces typings for the *submodule* nvg_
             """ Restore the previous render target"""
             pass
 
+        # void Resize(int width, int height);    /* original C++ signature */
+        def resize(self, width: int, height: int) -> None:
+            """ Resize: changes the size of the framebuffer, and reuses its texture when the new size fits in it.
+             Otherwise, the capacity grows by 1.5x at least, so that a drag-resize does not reallocate at each frame
+             (and a texture more than 4 times too large is reallocated).
+             Note: TextureId may change. Display the texture with uv1 = TextureUv1().
+            """
+            pass
+
+        # ImVec2 TextureUv1() const;    /* original C++ signature */
+        def texture_uv1(self) -> ImVec2:
+            """ The uv1 coordinates to use when displaying TextureId with ImGui::Image
+             (the texture may be larger than Width x Height)
+            """
+            pass
+
+        # void Invalidate();    /* original C++ signature */
+        def invalidate(self) -> None:
+            """ Invalidate: the next call to RenderNvgToFrameBufferIfChanged will redraw the framebuffer
+             (Resize() also invalidates it)
+            """
+            pass
+
+    class NvgFramebufferPool:
+        """ NvgFramebufferPool: keeps the textures of destroyed or resized NvgFramebuffers, so that they can be reused
+         by other framebuffers (e.g. several resizable NanoVG panels), instead of being deleted and reallocated.
+         Warning: the pool must outlive its framebuffers, and be destroyed when the renderer backend
+         and the NVGcontext are still valid
+        """
+        # NvgFramebufferPool(int maxPooledAllocations = 8);    /* original C++ signature */
+        def __init__(self, max_pooled_allocations: int = 8) -> None:
+            """ At most maxPooledAllocations unused textures are kept (the oldest ones are deleted first)"""
+            pass
+
+        # int NbPooledAllocations() const;    /* original C++ signature */
+        def nb_pooled_allocations(self) -> int:
+            """ Number of unused textures in the pool"""
+            pass
+
+        # void Clear();    /* original C++ signature */
+        def clear(self) -> None:
+            """ Deletes the unused textures"""
+            pass
+
 
 
     #/////////////////////////////////////////////////////////////////////////
@@ -1290,6 +1343,31 @@ class nvg_imgui:  # Proxy class that introduces typings for the *submodule* nvg_
         ) -> None:
         """ Render the given drawing function to the given framebuffer
          If clearColor.w > 0., the background will be cleared with this color
+         (the framebuffer is invalidated: the next call to RenderNvgToFrameBufferIfChanged will redraw it)
+        """
+        pass
+
+    # bool RenderNvgToFrameBufferIfChanged(    /* original C++ signature */
+    #         NVGcontext* vg,
+    #         NvgFramebuffer& texture,
+    #         NvgDrawingFunction drawFunc,
+    #         int64_t contentVersion,
+    #         ImVec4 clearColor = ImVec4(0.f, 0.f, 0.f, 1.f)
+    #         );
+    @staticmethod
+    def render_nvg_to_frame_buffer_if_changed(
+        vg: Context,
+        texture: NvgFramebuffer,
+        draw_func: NvgDrawingFunction,
+        content_version: int,
+        clear_color: ImVec4 = ImVec4(0., 0., 0., 1.)
+        ) -> bool:
+        """ Render the given drawing function to the given framebuffer, only if contentVersion changed
+         since the last call (or if the framebuffer was resized or invalidated).
+         Otherwise, the framebuffer texture is left untouched: a static drawing costs nothing.
+         contentVersion is any value (counter, hash...) which changes when the inputs of the drawing change
+         (it is signed, so that a python hash() can be used).
+         Returns True if the drawing function was called.
         """
         pass
 
@@ -1437,3 +1515,119 @@ def image_size(ctx: Context, image: int) -> Tuple[int, int]:
 ####################    </generated_from:nvg_cpp_text.h>    ####################
 
 # </litgen_stub> // Autogenerated code end!
+
+
+####################    Batched drawing, from numpy arrays    ####################
+# These functions draw many shapes with a single call (the NanoVG calls are issued by a C++ loop).
+# Arrays are converted to contiguous float32 (or int32 for offsets) arrays if needed.
+# If colors is None, all the shapes are added to a single path, painted once with the current fill (or stroke) style.
+# Otherwise, consecutive shapes with the same color are grouped in one path:
+# sorting the shapes by color reduces the number of paths (and draw calls).
+# These functions call begin_path(): they replace the current path.
+
+def draw_polylines(
+    ctx: Context,
+    points: np.ndarray,
+    offsets: np.ndarray,
+    colors: Optional[np.ndarray] = None,
+    closed: bool = False,
+    fill: bool = False,
+) -> None:
+    """ Draws many polylines with a single call.
+     points: array of shape (nb_points, 2)
+     offsets: nb_polylines + 1 indices into points: the polyline i uses points[offsets[i]:offsets[i+1]]
+     colors: optional array of shape (nb_polylines, 4) (RGBA floats). If None, the current style is used.
+     If fill is True the polylines are filled, otherwise they are stroked.
+    """
+    pass
+
+def draw_circles(
+    ctx: Context,
+    centers: np.ndarray,
+    radii: Optional[np.ndarray] = None,
+    radius: float = 1.0,
+    colors: Optional[np.ndarray] = None,
+    fill: bool = True,
+) -> None:
+    """ Draws many circles (e.g. markers) with a single call.
+     centers: array of shape (nb_circles, 2)
+     radii: optional array of shape (nb_circles,). If None, radius is used for all circles.
+     colors: optional array of shape (nb_circles, 4) (RGBA floats). If None, the current style is used.
+     If fill is True the circles are filled, otherwise they are stroked.
+    """
+    pass
+
+def draw_rects(
+    ctx: Context,
+    rects: np.ndarray,
+    colors: Optional[np.ndarray] = None,
+    fill: bool = True,
+) -> None:
+    """ Draws many rectangles with a single call.
+     rects: array of shape (nb_rects, 4), each row being (x, y, w, h)
+     colors: optional array of shape (nb_rects, 4) (RGBA floats). If None, the current style is used.
+     If fill is True the rectangles are filled, otherwise they are stroked.
+    """
+    pass
+
+
+####################    Text line breaking and glyph positions into reusable buffers    ####################
+
+class TextRowsBuffer:
+    """ The rows of a text broken into lines by text_break_lines_into(), stored as numpy arrays which are reused between calls.
+     The rows are given as byte offsets in the UTF-8 encoded text (i.e. text.encode()[starts[i]:ends[i]]).
+     starts, ends, widths, minxs and maxxs return views of these arrays (without copy):
+     their values are overwritten by the next call to text_break_lines_into() (copy them to keep them).
+    """
+    starts: np.ndarray  # Offset of the first byte of each row (int32)
+    ends: np.ndarray    # Offset after the last byte of each row (int32)
+    widths: np.ndarray  # Logical width of each row (float32)
+    minxs: np.ndarray   # Actual min x bound of each row (float32)
+    maxxs: np.ndarray   # Actual max x bound of each row (float32)
+
+    def __init__(self) -> None:
+        pass
+    def nb_rows(self) -> int:
+        pass
+    def clear(self) -> None:
+        pass
+
+def text_break_lines_into(
+    ctx: Context,
+    text: str,
+    break_row_width: float,
+    rows: TextRowsBuffer,
+) -> None:
+    """ Breaks the specified text into lines (same as text_break_lines), without limit on the number of rows.
+     The rows are written into a reusable buffer (whose previous content is replaced):
+     the rows text is not copied, and once the buffer is large enough, no allocation is done.
+    """
+    pass
+
+class GlyphPositionsBuffer:
+    """ The glyph positions of a text, filled by text_glyph_positions_into(), stored as numpy arrays which are reused between calls.
+     offsets, xs, minxs and maxxs return views of these arrays (without copy):
+     their values are overwritten by the next call to text_glyph_positions_into() (copy them to keep them).
+    """
+    offsets: np.ndarray  # Offset of each glyph in the UTF-8 encoded text (int32)
+    xs: np.ndarray       # The x-coordinate of the logical position of each glyph (float32)
+    minxs: np.ndarray    # The min x bound of the shape of each glyph (float32)
+    maxxs: np.ndarray    # The max x bound of the shape of each glyph (float32)
+
+    def __init__(self) -> None:
+        pass
+    def nb_glyphs(self) -> int:
+        pass
+
+def text_glyph_positions_into(
+    ctx: Context,
+    x: float,
+    y: float,
+    text: str,
+    glyphs: GlyphPositionsBuffer,
+) -> None:
+    """ Calculates the glyph x positions of the specified text (same as text_glyph_positions).
+     The positions are written into a reusable buffer (whose previous content is replaced):
+     once the buffer is large enough, no allocation is done.
+    """
+    pass
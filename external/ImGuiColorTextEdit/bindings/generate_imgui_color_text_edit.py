@@ -25,9 +25,12 @@ def main():
     options.member_exclude_by_type__regex = "Callback$|^char$"
     options.fn_return_force_policy_reference_for_references__regex = ".*"
     options.postprocess_stub_function = lambda s: s.replace("Optional[std.unordered_set<int>]", "Optional[Set[int]]")
+    # TextEditorChangeTracker keeps a reference to its editor, and is bound manually (with py::keep_alive)
+    options.class_exclude_by_name__regex = "^TextEditorChangeTracker$"
 
     generator = litgen.LitgenGenerator(options)
     generator.process_cpp_file(MAIN_DIR + "/ImGuiColorTextEdit/TextEditor.h")
+    generator.process_cpp_file(MAIN_DIR + "/bundle_integration/TextEditorChangeTracker.h")
 
     generator.write_generated_code(
         output_cpp_pydef_file=output_cpp_pydef_file,
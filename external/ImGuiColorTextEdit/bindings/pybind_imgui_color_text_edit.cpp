@@ -5,6 +5,7 @@
 #include <pybind11/numpy.h>
 
 #include "ImGuiColorTextEdit/TextEditor.h"
+#include "bundle_integration/TextEditorChangeTracker.h"
 
 namespace py = pybind11;
 
@@ -343,6 +344,50 @@ void py_init_module_imgui_color_text_edit(py::module& m)
         ;
     ////////////////////    </generated_from:TextEditor.h>    ////////////////////
 
+
+    ////////////////////    <generated_from:TextEditorChangeTracker.h>    ////////////////////
+    auto pyClassTextEditorDelta =
+        py::class_<TextEditorDelta>
+            (m, "TextEditorDelta", " TextEditorDelta: an edit between two versions of the text:\n the lines [StartLine, EndLine) of the previous version were replaced by InsertedLines")
+        .def(py::init<>([](
+        int Version = 0, int StartLine = 0, int EndLine = 0, std::vector<std::string> InsertedLines = std::vector<std::string>())
+        {
+            auto r = std::make_unique<TextEditorDelta>();
+            r->Version = Version;
+            r->StartLine = StartLine;
+            r->EndLine = EndLine;
+            r->InsertedLines = InsertedLines;
+            return r;
+        })
+        , py::arg("version") = 0, py::arg("start_line") = 0, py::arg("end_line") = 0, py::arg("inserted_lines") = std::vector<std::string>()
+        )
+        .def_readwrite("version", &TextEditorDelta::Version, "Version of the text after this edit")
+        .def_readwrite("start_line", &TextEditorDelta::StartLine, "")
+        .def_readwrite("end_line", &TextEditorDelta::EndLine, "")
+        .def_readwrite("inserted_lines", &TextEditorDelta::InsertedLines, "")
+        ;
+    ////////////////////    </generated_from:TextEditorChangeTracker.h>    ////////////////////
+
     // </litgen_pydef> // Autogenerated code end
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  AUTOGENERATED CODE END !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+
+    ////////////////////    TextEditorChangeTracker (bound manually: the tracker keeps its editor alive)    ////////////////////
+    py::class_<TextEditorChangeTracker>
+        (m, "TextEditorChangeTracker", " TextEditorChangeTracker: a version counter for the text of a TextEditor, and the deltas between versions.\n\n Call Update() once per frame, after TextEditor::Render(): when the text did not change, it only queries\n the editor flags and hashes the text (one GetText() copy, which detects a SetText() between two frames).\n When it did, the new lines are compared to the previous ones, and the changed range is recorded as a delta.\n Note: this comparison is O(file size) for each frame with an edit (all the lines are copied with\n GetTextLines(), and the tracker keeps its own copy of them): the tracker saves the consumer's work\n (it receives the changed lines only), not the editor side work.\n This lets a consumer sync with the editor incrementally, instead of processing the whole text at each frame.")
+        .def(py::init<TextEditor &, int>(),
+            py::arg("editor"), py::arg("max_deltas") = 256,
+            "The editor must outlive the tracker (in python, the tracker keeps the editor alive)",
+            py::keep_alive<1, 2>())
+        .def("update",
+            &TextEditorChangeTracker::Update, "Returns True if the text changed since the last call")
+        .def("get_version",
+            &TextEditorChangeTracker::GetVersion, "The version starts at 0, and is incremented at each change")
+        .def("get_oldest_available_version",
+            &TextEditorChangeTracker::GetOldestAvailableVersion, "Deltas older than this version were discarded (only maxDeltas deltas are kept)")
+        .def("get_deltas_since",
+            &TextEditorChangeTracker::GetDeltasSince,
+            py::arg("since_version"),
+            " Returns the deltas since sinceVersion, oldest first.\n If sinceVersion < GetOldestAvailableVersion(), some deltas are missing: resync with TextEditor::GetText() instead.")
+        ;
 }
@@ -0,0 +1,79 @@
+// Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#include "TextEditorChangeTracker.h"
+
+#include <algorithm>
+#include <functional>
+
+
+TextEditorChangeTracker::TextEditorChangeTracker(TextEditor& editor, int maxDeltas)
+    : mEditor(editor), mMaxDeltas(std::max(maxDeltas, 1))
+{
+    mLines = mEditor.GetTextLines();
+    mLastUndoIndex = mEditor.GetUndoIndex();
+    mTextHash = std::hash<std::string>()(mEditor.GetText());
+}
+
+bool TextEditorChangeTracker::Update()
+{
+    // IsTextChanged() covers the edits done during the last Render();
+    // the undo index and the number of lines cover most of the edits done by the API between two frames.
+    // A SetText() between two frames may leave no such trace (its flag is cleared by Render(), and it resets
+    // the undo index): it is detected by the hash of the text.
+    int undoIndex = mEditor.GetUndoIndex();
+    bool mayHaveChanged = mEditor.IsTextChanged()
+        || undoIndex != mLastUndoIndex
+        || mEditor.GetTotalLines() != (int)mLines.size();
+    mLastUndoIndex = undoIndex;
+    size_t textHash = std::hash<std::string>()(mEditor.GetText());
+    if (textHash != mTextHash)
+        mayHaveChanged = true;
+    mTextHash = textHash;
+    if (!mayHaveChanged)
+        return false;
+
+    std::vector<std::string> newLines = mEditor.GetTextLines();
+
+    // The changed range lies between the common prefix and the common suffix
+    size_t maxCommon = std::min(mLines.size(), newLines.size());
+    size_t prefix = 0;
+    while (prefix < maxCommon && mLines[prefix] == newLines[prefix])
+        ++prefix;
+    size_t suffix = 0;
+    while (suffix < maxCommon - prefix
+           && mLines[mLines.size() - 1 - suffix] == newLines[newLines.size() - 1 - suffix])
+        ++suffix;
+    if (prefix == mLines.size() && prefix == newLines.size())
+        return false;
+
+    TextEditorDelta delta;
+    delta.Version = ++mVersion;
+    delta.StartLine = (int)prefix;
+    delta.EndLine = (int)(mLines.size() - suffix);
+    delta.InsertedLines.assign(newLines.begin() + (std::ptrdiff_t)prefix, newLines.end() - (std::ptrdiff_t)suffix);
+    mDeltas.push_back(std::move(delta));
+    while ((int)mDeltas.size() > mMaxDeltas)
+        mDeltas.pop_front();
+
+    mLines = std::move(newLines);
+    return true;
+}
+
+int TextEditorChangeTracker::GetVersion() const
+{
+    return mVersion;
+}
+
+int TextEditorChangeTracker::GetOldestAvailableVersion() const
+{
+    // The delta of version v leads from v - 1 to v
+    return mDeltas.empty() ? mVersion : mDeltas.front().Version - 1;
+}
+
+std::vector<TextEditorDelta> TextEditorChangeTracker::GetDeltasSince(int sinceVersion) const
+{
+    std::vector<TextEditorDelta> r;
+    for (const auto& delta: mDeltas)
+        if (delta.Version > sinceVersion)
+            r.push_back(delta);
+    return r;
+}
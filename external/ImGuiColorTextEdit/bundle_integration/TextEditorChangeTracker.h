@@ -0,0 +1,57 @@
+// Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#pragma once
+#include "ImGuiColorTextEdit/TextEditor.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+
+// TextEditorDelta: an edit between two versions of the text:
+// the lines [StartLine, EndLine) of the previous version were replaced by InsertedLines
+struct TextEditorDelta
+{
+    int Version = 0;                        // Version of the text after this edit
+    int StartLine = 0;
+    int EndLine = 0;
+    std::vector<std::string> InsertedLines;
+};
+
+
+// TextEditorChangeTracker: a version counter for the text of a TextEditor, and the deltas between versions.
+//
+// Call Update() once per frame, after TextEditor::Render(): when the text did not change, it only queries
+// the editor flags and hashes the text (one GetText() copy, which detects a SetText() between two frames).
+// When it did, the new lines are compared to the previous ones, and the changed range is recorded as a delta.
+// Note: this comparison is O(file size) for each frame with an edit (all the lines are copied with
+// GetTextLines(), and the tracker keeps its own copy of them): the tracker saves the consumer's work
+// (it receives the changed lines only), not the editor side work.
+// This lets a consumer sync with the editor incrementally, instead of processing the whole text at each frame.
+class TextEditorChangeTracker
+{
+public:
+    // The editor must outlive the tracker
+    TextEditorChangeTracker(TextEditor& editor, int maxDeltas = 256);
+
+    // Returns true if the text changed since the last call
+    bool Update();
+
+    // The version starts at 0, and is incremented at each change
+    int GetVersion() const;
+
+    // Deltas older than this version were discarded (only maxDeltas deltas are kept)
+    int GetOldestAvailableVersion() const;
+
+    // Returns the deltas since sinceVersion, oldest first.
+    // If sinceVersion < GetOldestAvailableVersion(), some deltas are missing: resync with TextEditor::GetText() instead.
+    std::vector<TextEditorDelta> GetDeltasSince(int sinceVersion) const;
+
+private:
+    TextEditor& mEditor;
+    int mMaxDeltas;
+    int mVersion = 0;
+    int mLastUndoIndex = 0;
+    size_t mTextHash = 0;
+    std::vector<std::string> mLines;
+    std::deque<TextEditorDelta> mDeltas;
+};
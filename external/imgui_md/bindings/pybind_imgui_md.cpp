@@ -29,6 +29,8 @@ void py_init_module_imgui_md(py::module& m)
         .def_readwrite("max_header_level", &ImGuiMd::MarkdownFontOptions::maxHeaderLevel, "")
         .def_readwrite("size_diff_between_levels", &ImGuiMd::MarkdownFontOptions::sizeDiffBetweenLevels, "")
         .def_readwrite("regular_size", &ImGuiMd::MarkdownFontOptions::regularSize, "")
+        .def_readwrite("scale_header_fonts", &ImGuiMd::MarkdownFontOptions::scaleHeaderFonts, " If scaleHeaderFonts is True, only one header font (at the largest header size) is loaded\n per emphasis variant, and the smaller header levels are rendered by scaling it down.\n This keeps the font atlas small when maxHeaderLevel is large\n (at the cost of slightly less crisp small headers).")
+        .def_readwrite("lazy_load_rare_fonts", &ImGuiMd::MarkdownFontOptions::lazyLoadRareFonts, " If lazyLoadRareFonts is True, the rarely used font variants (bold italic text, bold or italic headers)\n are loaded only when a document first uses them, at the next frame boundary (HelloImGui only).\n Until then, the same text with less emphasis is displayed. This keeps the font atlas smaller.")
         ;
 
 
@@ -68,6 +70,23 @@ void py_init_module_imgui_md(py::module& m)
         .def(py::init<>()) // implicit default constructor
         .def_readwrite("font_options", &ImGuiMd::MarkdownOptions::fontOptions, "")
         .def_readwrite("callbacks", &ImGuiMd::MarkdownOptions::callbacks, "")
+        .def_readwrite("with_block_cache", &ImGuiMd::MarkdownOptions::withBlockCache, " If withBlockCache is True, Render() splits each markdown string into its top-level blocks\n (paragraphs, lists, tables, code blocks...) once, and remembers the height of each block:\n only the visible blocks are rendered, the others are replaced by an empty space (so that a long document scrolls as fast as a short one).\n All the blocks are rendered again when the available width or the font size change, in order to measure them.\n (html blocks such as divs are never split, so that OnHtmlDiv calls stay paired, and neither are loose lists)")
+        .def_readwrite("image_cache_budget_mb", &ImGuiMd::MarkdownOptions::imageCacheBudgetMB, " The images displayed by OnImage_Default are read and decoded by a worker thread\n (a placeholder of the right size is displayed in the meantime).\n Their textures (and the decoded images which wait for their upload) are kept in a cache whose memory\n is limited to imageCacheBudgetMB: when it is exceeded, the least recently displayed images are evicted,\n except those displayed during the last 60 frames.")
+        ;
+
+
+    auto pyClassMarkdownImageCacheStats =
+        py::class_<ImGuiMd::MarkdownImageCacheStats>
+            (m, "MarkdownImageCacheStats", "Statistics of the image cache used by OnImage_Default")
+        .def(py::init<>()) // implicit default constructor
+        .def_readwrite("nb_textures", &ImGuiMd::MarkdownImageCacheStats::nbTextures, "Number of textures in the cache")
+        .def_readwrite("texture_bytes", &ImGuiMd::MarkdownImageCacheStats::textureBytes, "Memory used by these textures")
+        .def_readwrite("budget_bytes", &ImGuiMd::MarkdownImageCacheStats::budgetBytes, "")
+        .def_readwrite("nb_pending_images", &ImGuiMd::MarkdownImageCacheStats::nbPendingImages, "Images being read and decoded")
+        .def_readwrite("decoded_bytes", &ImGuiMd::MarkdownImageCacheStats::decodedBytes, "Memory used by the decoded images which wait for their upload (counts toward the budget)")
+        .def_readwrite("nb_uploaded_images", &ImGuiMd::MarkdownImageCacheStats::nbUploadedImages, "Total number of images uploaded as textures")
+        .def_readwrite("nb_evicted_images", &ImGuiMd::MarkdownImageCacheStats::nbEvictedImages, "Total number of images evicted from the cache")
+        .def_readwrite("nb_failed_images", &ImGuiMd::MarkdownImageCacheStats::nbFailedImages, "Images which could not be read or decoded")
         ;
 
 
@@ -75,11 +94,17 @@ void py_init_module_imgui_md(py::module& m)
         ImGuiMd::InitializeMarkdown, py::arg("options") = ImGuiMd::MarkdownOptions());
 
     m.def("de_initialize_markdown",
-        ImGuiMd::DeInitializeMarkdown);
+        ImGuiMd::DeInitializeMarkdown, " DeInitializeMarkdown: destroys the renderer and the textures of its images:\n call it while OpenGL is still initialized (e.g. in callbacks.BeforeExit). ImmApp::Run does this automatically.");
 
     m.def("get_font_loader_function",
         ImGuiMd::GetFontLoaderFunction, "GetFontLoaderFunction() will return a function that you should call during ImGui initialization.");
 
+    m.def("enable_lazy_font_loading",
+        ImGuiMd::EnableLazyFontLoading, " EnableLazyFontLoading: (HelloImGui only) instead of loading the fonts at startup via GetFontLoaderFunction(),\n you may call this after InitializeMarkdown(): the fonts will then be loaded at the next frame boundary\n after the first call to Render() or GetCodeFont().\n Until the fonts are loaded, Render() displays nothing and GetCodeFont() returns None.");
+
+    m.def("are_fonts_loaded",
+        ImGuiMd::AreFontsLoaded, "AreFontsLoaded returns True once the markdown fonts are loaded");
+
     m.def("render",
         ImGuiMd::Render,
         py::arg("markdown_string"),
@@ -92,6 +117,26 @@ void py_init_module_imgui_md(py::module& m)
 
     m.def("get_code_font",
         ImGuiMd::GetCodeFont, pybind11::return_value_policy::reference);
+
+    m.def("get_image_cache_stats",
+        ImGuiMd::GetImageCacheStats, "GetImageCacheStats: statistics of the image cache used by OnImage_Default (see MarkdownOptions.imageCacheBudgetMB)");
+
+
+    auto pyClassMarkdownStream =
+        py::class_<ImGuiMd::MarkdownStream>
+            (m, "MarkdownStream", " MarkdownStream: renders a markdown text which grows over time (job reports, streamed outputs, logs...)\n Calling Render() on an ever-longer string costs O(total length) at each frame. Instead, Append() only scans\n the new text from the last block boundary, and Render() reuses the heights of the completed blocks:\n only the visible blocks and the last block (which may still grow) are rendered.\n (the text is split into blocks as with MarkdownOptions.withBlockCache)")
+        .def(py::init<>())
+        .def("append",
+            &ImGuiMd::MarkdownStream::Append,
+            py::arg("text"),
+            "Appends some markdown text (which may end in the middle of a line)")
+        .def("clear",
+            &ImGuiMd::MarkdownStream::Clear, "Removes all the text")
+        .def("get_text",
+            &ImGuiMd::MarkdownStream::GetText)
+        .def("render",
+            &ImGuiMd::MarkdownStream::Render, "Renders the text (InitializeMarkdown must have been called, as for Render)")
+        ;
     ////////////////////    </generated_from:imgui_md_wrapper.h>    ////////////////////
 
     // </litgen_pydef> // Autogenerated code end
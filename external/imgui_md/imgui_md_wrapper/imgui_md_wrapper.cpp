@@ -1,26 +1,35 @@
 // Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
 #include "imgui_md_wrapper.h"
+#include "markdown_image_cache.h"
 
 #ifdef HELLOIMGUI_HAS_OPENGL // Image rendering with markdown only works with OpenGl
 #define CAN_RENDER_IMAGES
 #endif
 
 #include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/functional_utils.h"
 #include "immapp/snippets.h"
 
 #include "imgui.h"
+#include "imgui_internal.h"
 #include "imgui_md/imgui_md.h"
 #include "immapp/code_utils.h"
 #include "immapp/browse_to_url.h"
 
 #include <fplus/fplus.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <iostream>
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstring>
 
 
 namespace ImGuiMd
@@ -37,16 +46,6 @@ namespace ImGuiMd
                 return (rhs.italic == italic) && (rhs.bold == bold);
             }
 
-            static std::vector<MarkdownEmphasis> AllEmphasisVariants()
-            {
-                return {
-                    { false, false },
-                    { false, true },
-                    { true, false },
-                    { true, true },
-                };
-            }
-
             bool IsDefault() { return  (!italic && !bold); }
         };
 
@@ -97,6 +96,69 @@ namespace ImGuiMd
         };
 
 
+        // A header font rendered by scaling down a larger header font (see MarkdownFontOptions.scaleHeaderFonts).
+        // It uses the atlas texture of the larger font, with a copy of its glyph tables.
+        // An atlas rebuild may move the glyphs in the texture while keeping the same glyph table
+        // (same address, size and font size): once per frame, the glyphs are compared to the copy,
+        // which is refreshed when they differ.
+        struct ScaledFont
+        {
+            MarkdownTextStyle markdownTextStyle;
+            ImFont* baseFont = nullptr;
+            float scale = 1.f;
+
+            std::unique_ptr<ImFont> font = std::make_unique<ImFont>();
+            int checkedFrame = -1;
+
+            bool IsSynced() const
+            {
+                return (font->FontSize == baseFont->FontSize)
+                       && (font->Scale == baseFont->Scale * scale)
+                       && (font->Ascent == baseFont->Ascent)
+                       && (font->Descent == baseFont->Descent)
+                       && (font->Glyphs.Size == baseFont->Glyphs.Size)
+                       && (font->Glyphs.Size == 0
+                           || memcmp(font->Glyphs.Data, baseFont->Glyphs.Data, (size_t)font->Glyphs.Size * sizeof(ImFontGlyph)) == 0);
+            }
+
+            ImFont* GetFont()
+            {
+                int frameCount = ImGui::GetFrameCount();
+                if (checkedFrame == frameCount)
+                    return font.get();
+                checkedFrame = frameCount;
+                if (!IsSynced())
+                {
+                    *font = *baseFont;
+                    if (baseFont->FallbackGlyph != nullptr)
+                        font->FallbackGlyph = font->Glyphs.Data + (baseFont->FallbackGlyph - baseFont->Glyphs.Data);
+                    font->Scale = baseFont->Scale * scale;
+                }
+                return font.get();
+            }
+        };
+
+
+        const char* gMissingFontAssetsMessage = R"(
+Could not find required assets for ImGuiMd:
+We need to find the following files in the assets:
+
+assets/
+├── fonts/
+│     ├── Roboto/
+│     │     ├── LICENSE.txt
+│     │     ├── Roboto-Bold.ttf
+│     │     ├── Roboto-BoldItalic.ttf
+│     │     ├── Roboto-Regular.ttf
+│     │     ├── Roboto-RegularItalic.ttf
+│     ├── SourceCodePro-Regular
+│     └── fontawesome-webfont.ttf
+└── images/
+    └── markdown_broken_image.png
+
+)";
+
+
         class FontCollection
         {
         public:
@@ -112,102 +174,473 @@ namespace ImGuiMd
 
             ImFont* GetDefaultFont() const
             {
-                auto defaultMarkdownStyle = MarkdownTextStyle{};
-                return GetFont(defaultMarkdownStyle);
+                return mFontTable[0].font;
             }
 
-            ImFont* GetFont(const MarkdownTextStyle& _markdownTextStyle) const
+            ImFont* GetFont(const MarkdownTextStyle& markdownTextStyle) const
             {
-                MarkdownTextStyle markdownTextStyle = _markdownTextStyle;
-                if (markdownTextStyle.headerLevel < 0)
-                    markdownTextStyle.headerLevel = 0;
-                if (markdownTextStyle.headerLevel > mMarkdownFontOptions.maxHeaderLevel)
-                    markdownTextStyle.headerLevel = mMarkdownFontOptions.maxHeaderLevel;
+                int headerLevel = std::clamp(markdownTextStyle.headerLevel, 0, mMarkdownFontOptions.maxHeaderLevel);
+                bool bold = markdownTextStyle.markdownEmphasis.bold;
+                bool italic = markdownTextStyle.markdownEmphasis.italic;
 
-                for (auto pair: mFonts)
+                // Until a lazy font is loaded, the same header level with less emphasis is used
+                const bool emphasisCandidates[4][2] = { { bold, italic }, { bold, false }, { false, italic }, { false, false } };
+                for (const auto& emphasis: emphasisCandidates)
                 {
-                    if (pair.first == markdownTextStyle)
-                        return pair.second;
+                    ImFont* font = ResolveSlot(SlotIndex(headerLevel, emphasis[0], emphasis[1]));
+                    if (font != nullptr)
+                        return font;
                 }
                 assert(false);
                 return nullptr;
             }
         private:
-            void LoadFonts()
+            // The fonts are stored in a table indexed by [headerLevel][bold][italic]
+            struct FontSlot
             {
-                std::string error_message = R"(
-Could not find required assets for ImGuiMd:
-We need to find the following files in the assets:
+                ImFont* font = nullptr;         // nullptr for the scaled fonts, and for the lazy fonts until they are loaded
+                int scaledFontIndex = -1;       // Index in mScaledFonts (see MarkdownFontOptions.scaleHeaderFonts)
+                size_t baseSlotIndex = 0;       // For the scaled fonts: slot of the larger font
+                bool isLoadRequested = false;
+            };
 
-assets/
-├── fonts/
-│     ├── Roboto/
-│     │     ├── LICENSE.txt
-│     │     ├── Roboto-Bold.ttf
-│     │     ├── Roboto-BoldItalic.ttf
-│     │     ├── Roboto-Regular.ttf
-│     │     ├── Roboto-RegularItalic.ttf
-│     ├── SourceCodePro-Regular
-│     └── fontawesome-webfont.ttf
-└── images/
-    └── markdown_broken_image.png
+            static size_t SlotIndex(int headerLevel, bool bold, bool italic)
+            {
+                return ((size_t)headerLevel * 2 + (bold ? 1 : 0)) * 2 + (italic ? 1 : 0);
+            }
 
-)";
-                for (int header_level = 0; header_level <= mMarkdownFontOptions.maxHeaderLevel; ++header_level)
+            static MarkdownTextStyle SlotTextStyle(size_t slotIndex)
+            {
+                MarkdownTextStyle r;
+                r.headerLevel = (int)(slotIndex / 4);
+                r.markdownEmphasis.bold = (slotIndex / 2) % 2 == 1;
+                r.markdownEmphasis.italic = slotIndex % 2 == 1;
+                return r;
+            }
+
+            // Returns the font of a slot, or nullptr if it is not loaded yet (its loading is then requested)
+            ImFont* ResolveSlot(size_t slotIndex) const
+            {
+                FontSlot& slot = mFontTable[slotIndex];
+                if (slot.scaledFontIndex >= 0)
                 {
-                    for (auto emphasisVariant: MarkdownEmphasis::AllEmphasisVariants())
-                    {
-                        MarkdownTextStyle markdownTextStyle;
-                        markdownTextStyle.markdownEmphasis = emphasisVariant;
-                        markdownTextStyle.headerLevel = header_level;
-
-                        float fontSize = MarkdownFontOptions_FontSize(mMarkdownFontOptions, header_level);
-                        std::string fontFile = MarkdownFontOptions_FontFilename(mMarkdownFontOptions, emphasisVariant);
-
-                        // we shall not load the icons for all the fonts variants, since the font atlas
-                        // texture might end up too big to fit in the GPU.
-                        ImFont * font;
-                        if (markdownTextStyle.IsDefault())
-                            font = HelloImGui::LoadFontTTF_WithFontAwesomeIcons(fontFile, fontSize);
-                        else
-                            font = HelloImGui::LoadFontTTF(fontFile, fontSize);
-
-                        if (font == nullptr)
-                        {
-                            fprintf(stderr, "%s", error_message.c_str());
-                            IM_ASSERT(false);
-                        }
+                    ScaledFont& scaledFont = mScaledFonts[(size_t)slot.scaledFontIndex];
+                    if (scaledFont.baseFont == nullptr)
+                        scaledFont.baseFont = ResolveSlot(slot.baseSlotIndex);
+                    return scaledFont.baseFont != nullptr ? scaledFont.GetFont() : nullptr;
+                }
+                if (slot.font == nullptr)
+                    RequestFontLoading(slotIndex);
+                return slot.font;
+            }
+
+            // With lazyLoadRareFonts, the rare variants are loaded at the next frame boundary,
+            // via HelloImGui's LoadAdditionalFonts callback
+            void RequestFontLoading(size_t slotIndex) const
+            {
+                FontSlot& slot = mFontTable[slotIndex];
+                if (slot.isLoadRequested)
+                    return;
+                auto runnerParams = HelloImGui::GetRunnerParams();
+                if (runnerParams == nullptr)
+                    return;
+                slot.isLoadRequested = true;
+
+                auto loadFont = [this, slotIndex]()
+                {
+                    mFontTable[slotIndex].font = LoadFontVariant(SlotTextStyle(slotIndex));
+                };
+                auto& loadAdditionalFonts = runnerParams->callbacks.LoadAdditionalFonts;
+                if (loadAdditionalFonts)
+                    loadAdditionalFonts = HelloImGui::SequenceFunctions(loadAdditionalFonts, loadFont);
+                else
+                    loadAdditionalFonts = loadFont;
+            }
+
+            // Bold italic text, and bold or italic headers
+            static bool IsRareVariant(const MarkdownTextStyle& markdownTextStyle)
+            {
+                const auto& emphasis = markdownTextStyle.markdownEmphasis;
+                if (markdownTextStyle.headerLevel > 0)
+                    return emphasis.bold || emphasis.italic;
+                else
+                    return emphasis.bold && emphasis.italic;
+            }
+
+            ImFont* LoadFontVariant(MarkdownTextStyle markdownTextStyle) const
+            {
+                float fontSize = MarkdownFontOptions_FontSize(mMarkdownFontOptions, markdownTextStyle.headerLevel);
+                std::string fontFile = MarkdownFontOptions_FontFilename(mMarkdownFontOptions, markdownTextStyle.markdownEmphasis);
+
+                // we shall not load the icons for all the fonts variants, since the font atlas
+                // texture might end up too big to fit in the GPU.
+                ImFont * font;
+                if (markdownTextStyle.IsDefault())
+                    font = HelloImGui::LoadFontTTF_WithFontAwesomeIcons(fontFile, fontSize);
+                else
+                    font = HelloImGui::LoadFontTTF(fontFile, fontSize);
+
+                if (font == nullptr)
+                {
+                    fprintf(stderr, "%s", gMissingFontAssetsMessage);
+                    IM_ASSERT(false);
+                }
+                return font;
+            }
+
+            void LoadFonts()
+            {
+                mFontTable.resize(SlotIndex(mMarkdownFontOptions.maxHeaderLevel, true, true) + 1);
+                for (size_t slotIndex = 0; slotIndex < mFontTable.size(); ++slotIndex)
+                {
+                    FontSlot& slot = mFontTable[slotIndex];
+                    MarkdownTextStyle markdownTextStyle = SlotTextStyle(slotIndex);
+                    int header_level = markdownTextStyle.headerLevel;
 
-                        mFonts.push_back(std::make_pair(markdownTextStyle, font) );
+                    // With scaleHeaderFonts, the headers below level 1 (the largest) reuse its font
+                    if (mMarkdownFontOptions.scaleHeaderFonts && header_level >= 2)
+                    {
+                        const auto& emphasis = markdownTextStyle.markdownEmphasis;
+                        slot.baseSlotIndex = SlotIndex(1, emphasis.bold, emphasis.italic);
+                        ScaledFont scaledFont;
+                        scaledFont.markdownTextStyle = markdownTextStyle;
+                        scaledFont.baseFont = mFontTable[slot.baseSlotIndex].font;   // nullptr for a lazy font
+                        scaledFont.scale = MarkdownFontOptions_FontSize(mMarkdownFontOptions, header_level)
+                                           / MarkdownFontOptions_FontSize(mMarkdownFontOptions, 1);
+                        slot.scaledFontIndex = (int)mScaledFonts.size();
+                        mScaledFonts.push_back(std::move(scaledFont));
+                        continue;
                     }
+
+                    if (mMarkdownFontOptions.lazyLoadRareFonts && IsRareVariant(markdownTextStyle))
+                        continue;
+                    slot.font = LoadFontVariant(markdownTextStyle);
                 }
 
                 float fontSize = MarkdownFontOptions_FontSize(mMarkdownFontOptions, 0);
                 mFontCode = HelloImGui::LoadFontTTF(
                     "fonts/SourceCodePro-Regular.ttf", fontSize);
                 if (mFontCode == nullptr) {
-                    fprintf(stderr, "%s", error_message.c_str());
+                    fprintf(stderr, "%s", gMissingFontAssetsMessage);
                     IM_ASSERT(false);
                 }
             }
 
             MarkdownFontOptions mMarkdownFontOptions;
-            std::vector<std::pair<MarkdownTextStyle, ImFont*>> mFonts;
+            mutable std::vector<FontSlot> mFontTable;
+            mutable std::vector<ScaledFont> mScaledFonts;
             ImFont* mFontCode;
         };
 
     } //namespace MdFonts
 
+    namespace ImGuiMdBlockCache
+    {
+        struct MarkdownBlock
+        {
+            std::string source;         // Followed by the link reference definitions of the document
+            float height = -1.f;        // Height of the rendered block (-1 if not measured yet)
+        };
+
+        struct MarkdownDocument
+        {
+            std::string source;         // Copy of the markdown string (so that it is not hashed at each frame)
+            ImGuiID sourceFingerprint = 0;
+            std::vector<MarkdownBlock> blocks;
+            // Prefix sums of the heights of the measured blocks (the first nbMeasuredBlocks blocks):
+            // top of each block, followed by the bottom of the last measured block
+            std::vector<float> blockTops = { 0.f };
+            size_t nbMeasuredBlocks = 0;
+            float width = -1.f;         // Width and font size at which the heights were measured
+            float fontSize = -1.f;
+            int lastFrame = -1;
+        };
+
+        // A cheap hash of a few samples of the source: an edited document is usually detected
+        // without a full comparison with its copy
+        ImGuiID SourceFingerprint(const std::string& source)
+        {
+            const size_t kNbSamples = 16, kSampleSize = 64;
+            if (source.size() <= kNbSamples * kSampleSize)
+                return ImHashData(source.data(), source.size());
+            ImGuiID r = 0;
+            for (size_t i = 0; i < kNbSamples; ++i)
+            {
+                size_t offset = source.size() * i / kNbSamples;
+                r = ImHashData(source.data() + offset, std::min(kSampleSize, source.size() - offset), r);
+            }
+            return r;
+        }
+
+        // Updates the prefix sums, from the block fromBlock
+        void UpdateBlockTops(MarkdownDocument* document, size_t fromBlock)
+        {
+            fromBlock = std::min(fromBlock, document->nbMeasuredBlocks);
+            document->nbMeasuredBlocks = document->blocks.size();
+            document->blockTops.resize(document->blocks.size() + 1);
+            for (size_t i = fromBlock; i < document->blocks.size(); ++i)
+                document->blockTops[i + 1] = document->blockTops[i] + document->blocks[i].height;
+        }
+
+        // The blocks from fromBlock will be measured again at the next frame
+        void InvalidateBlockTops(MarkdownDocument* document, size_t fromBlock)
+        {
+            document->nbMeasuredBlocks = std::min(document->nbMeasuredBlocks, fromBlock);
+            document->blockTops.resize(document->nbMeasuredBlocks + 1);
+        }
+
+        // Adds an empty space, whose height includes the item spacing (as the measured block heights)
+        void AddVerticalSpace(float height)
+        {
+            if (height > 0.f)
+                ImGui::Dummy(ImVec2(0.f, std::max(height - ImGui::GetStyle().ItemSpacing.y, 0.f)));
+        }
+
+
+        bool IsBlankLine(std::string_view line)
+        {
+            return std::all_of(line.begin(), line.end(), [](char c) { return c == ' ' || c == '\t' || c == '\r'; });
+        }
+
+        int IndentWidth(std::string_view line)
+        {
+            int r = 0;
+            for (char c: line)
+            {
+                if (c == ' ')
+                    r += 1;
+                else if (c == '\t')
+                    r += 4;
+                else
+                    break;
+            }
+            return r;
+        }
+
+        bool StartsWith(std::string_view s, std::string_view prefix)
+        {
+            return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+        }
+
+        // "***", "- - -", "___": a thematic break (which is not a list item)
+        bool IsThematicBreak(std::string_view trimmedLine)
+        {
+            char c = trimmedLine.empty() ? 0 : trimmedLine[0];
+            if (c != '-' && c != '*' && c != '_')
+                return false;
+            int nbMarks = 0;
+            for (char x: trimmedLine)
+            {
+                if (x == c)
+                    ++nbMarks;
+                else if (x != ' ' && x != '\t' && x != '\r')
+                    return false;
+            }
+            return nbMarks >= 3;
+        }
+
+        // The marker of a list item: '-', '*' or '+' for bullet lists, '.' or ')' for ordered lists, 0 if not a list item
+        char ListItemMarker(std::string_view trimmedLine)
+        {
+            if (trimmedLine.empty() || IsThematicBreak(trimmedLine))
+                return 0;
+            char marker = trimmedLine[0];
+            size_t markerEnd = 1;
+            if (marker != '-' && marker != '*' && marker != '+')
+            {
+                size_t nbDigits = 0;
+                while (nbDigits < trimmedLine.size() && std::isdigit((unsigned char)trimmedLine[nbDigits]))
+                    ++nbDigits;
+                if (nbDigits == 0 || nbDigits > 9 || nbDigits >= trimmedLine.size())
+                    return 0;
+                marker = trimmedLine[nbDigits];
+                if (marker != '.' && marker != ')')
+                    return 0;
+                markerEnd = nbDigits + 1;
+            }
+            if (markerEnd < trimmedLine.size() && !IsBlankLine(trimmedLine.substr(markerEnd, 1)))
+                return 0;
+            return marker;
+        }
+
+        // The change of nesting depth of the html block elements (div, details, table...) in a line.
+        // The elements whose end tag is optional (p, li, td...) and the void elements (hr, br...) are ignored.
+        int HtmlBlockDepthChange(std::string_view line)
+        {
+            static const std::unordered_set<std::string> kBlockTags = {
+                "address", "article", "aside", "blockquote", "center", "details", "dialog", "dir", "div", "dl",
+                "fieldset", "figcaption", "figure", "footer", "form", "frameset", "h1", "h2", "h3", "h4", "h5", "h6",
+                "header", "iframe", "legend", "main", "menu", "nav", "noframes", "ol", "pre", "script", "search",
+                "section", "style", "summary", "table", "textarea", "ul"
+            };
+            int r = 0;
+            for (size_t pos = line.find('<'); pos != std::string_view::npos; pos = line.find('<', pos + 1))
+            {
+                size_t nameStart = pos + 1;
+                bool isEndTag = nameStart < line.size() && line[nameStart] == '/';
+                if (isEndTag)
+                    ++nameStart;
+                size_t nameEnd = nameStart;
+                while (nameEnd < line.size() && std::isalnum((unsigned char)line[nameEnd]))
+                    ++nameEnd;
+                if (nameEnd == nameStart || nameEnd - nameStart > 10)
+                    continue;
+                if (nameEnd < line.size() && line[nameEnd] != '>' && line[nameEnd] != '/' && !IsBlankLine(line.substr(nameEnd, 1)))
+                    continue;
+                std::string name(line.substr(nameStart, nameEnd - nameStart));
+                std::transform(name.begin(), name.end(), name.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+                if (kBlockTags.count(name) == 0)
+                    continue;
+                if (isEndTag)
+                    --r;
+                else
+                {
+                    size_t tagEnd = line.find('>', nameEnd);
+                    bool isSelfClosing = tagEnd != std::string_view::npos && line[tagEnd - 1] == '/';
+                    if (!isSelfClosing)
+                        ++r;
+                }
+            }
+            return r;
+        }
+
+        // "[label]: url": a link reference definition
+        bool IsLinkReferenceDefinition(std::string_view trimmedLine)
+        {
+            if (!StartsWith(trimmedLine, "["))
+                return false;
+            size_t close = trimmedLine.find(']');
+            return close != std::string_view::npos && close > 1
+                && close + 1 < trimmedLine.size() && trimmedLine[close + 1] == ':';
+        }
+
+        // BlockSplitter: finds the top-level blocks of a markdown text, at the blank lines which are followed by
+        // a non indented line (an indented line may continue a list item or an indented code block),
+        // except inside fenced code blocks, html comments and html blocks (div, details, table...),
+        // and between the items of a loose list (a list whose items are separated by blank lines).
+        // The text may be scanned incrementally, while it grows: the blocks found so far do not change.
+        class BlockSplitter
+        {
+        public:
+            // Start of each block found so far
+            std::vector<size_t> blockStarts = { 0 };
+            // The link reference definitions are appended to all blocks, so that the links still resolve
+            std::string linkReferenceDefinitions;
+
+            // Scans the lines which were not scanned yet.
+            // If isTextComplete is false, a last line which does not end with '\n' is not scanned (it may still grow)
+            void Scan(const std::string& text, bool isTextComplete)
+            {
+                while (mPos < text.size())
+                {
+                    size_t eol = text.find('\n', mPos);
+                    if (eol == std::string::npos)
+                    {
+                        if (!isTextComplete)
+                            return;
+                        eol = text.size();
+                    }
+                    ScanLine(std::string_view(text.data() + mPos, eol - mPos), mPos);
+                    mPos = eol + 1;
+                }
+            }
+
+            // Source of a block (the last block ends at the end of the text)
+            std::string BlockSource(const std::string& text, size_t blockIndex) const
+            {
+                size_t begin = blockStarts[blockIndex];
+                size_t end = blockIndex + 1 < blockStarts.size() ? blockStarts[blockIndex + 1] : text.size();
+                std::string r = text.substr(begin, end - begin);
+                if (!linkReferenceDefinitions.empty())
+                    r += "\n\n" + linkReferenceDefinitions;
+                return r;
+            }
+
+        private:
+            void ScanLine(std::string_view line, size_t lineStart)
+            {
+                bool isBlank = IsBlankLine(line);
+                int indent = IndentWidth(line);
+                std::string_view trimmedLine = line.substr(std::min(line.find_first_not_of(" \t"), line.size()));
+
+                bool canSplit = !mIsInFence && !mIsInHtmlComment && mHtmlBlockDepth == 0;
+                char listMarker = ListItemMarker(trimmedLine);
+                bool continuesList = listMarker != 0 && listMarker == mListMarker;
+                if (canSplit && mWasPreviousLineBlank && !isBlank && indent == 0 && !continuesList && lineStart > blockStarts.back())
+                    blockStarts.push_back(lineStart);
+
+                // The top-level list ends at a non indented line which follows a blank line, and is not an item
+                // (a non indented line which follows a non blank line may be a lazy continuation of an item)
+                if (!mIsInFence && !mIsInHtmlComment && !isBlank && indent == 0)
+                {
+                    if (listMarker != 0)
+                        mListMarker = listMarker;
+                    else if (mWasPreviousLineBlank)
+                        mListMarker = 0;
+                }
+
+                if (mIsInFence)
+                {
+                    size_t nbFenceChars = std::min(trimmedLine.find_first_not_of(mFenceChar), trimmedLine.size());
+                    if (indent < 4 && nbFenceChars >= mFenceLength && IsBlankLine(trimmedLine.substr(nbFenceChars)))
+                        mIsInFence = false;
+                }
+                else if (mIsInHtmlComment)
+                {
+                    if (line.find("-->") != std::string_view::npos)
+                        mIsInHtmlComment = false;
+                }
+                else if (indent < 4)
+                {
+                    if (StartsWith(trimmedLine, "```") || StartsWith(trimmedLine, "~~~"))
+                    {
+                        mIsInFence = true;
+                        mFenceChar = trimmedLine[0];
+                        mFenceLength = std::min(trimmedLine.find_first_not_of(mFenceChar), trimmedLine.size());
+                    }
+                    else if (StartsWith(trimmedLine, "<!--"))
+                        mIsInHtmlComment = trimmedLine.find("-->", 4) == std::string_view::npos;
+                    else
+                    {
+                        mHtmlBlockDepth += HtmlBlockDepthChange(line);
+                        mHtmlBlockDepth = std::max(mHtmlBlockDepth, 0);
+                        if (IsLinkReferenceDefinition(trimmedLine))
+                        {
+                            linkReferenceDefinitions += line;
+                            linkReferenceDefinitions += "\n";
+                        }
+                    }
+                }
+
+                mWasPreviousLineBlank = isBlank;
+            }
+
+            size_t mPos = 0;
+            bool mIsInFence = false, mIsInHtmlComment = false, mWasPreviousLineBlank = false;
+            char mFenceChar = 0;
+            size_t mFenceLength = 0;
+            int mHtmlBlockDepth = 0;
+            char mListMarker = 0;       // Marker of the current top-level list items, 0 outside of a list
+        };
+
+        std::vector<MarkdownBlock> SplitBlocks(const std::string& markdown)
+        {
+            BlockSplitter splitter;
+            splitter.Scan(markdown, true);
+            std::vector<MarkdownBlock> blocks(splitter.blockStarts.size());
+            for (size_t i = 0; i < blocks.size(); ++i)
+                blocks[i].source = splitter.BlockSource(markdown, i);
+            return blocks;
+        }
+    } // namespace ImGuiMdBlockCache
+
+
     struct MarkdownCollection
     {
         MarkdownCollection(const MarkdownFontOptions& options)
             : mFontCollection(options)
         {}
         ImGuiMdFonts::FontCollection mFontCollection;
-
-#ifdef CAN_RENDER_IMAGES
-        mutable std::map<std::string, HelloImGui::ImageAndSize > mLoadedImages;
-#endif
     };
 
 
@@ -216,27 +649,50 @@ assets/
     private:
         MarkdownOptions mMarkdownOptions;
         MarkdownCollection mMarkdownCollection;
+#ifdef CAN_RENDER_IMAGES
+        MarkdownImageCache mImageCache;
+#endif
         std::map<std::string, Snippets::SnippetData> mSnippets;
+        // Documents rendered with withBlockCache, keyed by a hash of their content (and of the ImGui ID stack)
+        std::unordered_map<ImGuiID, ImGuiMdBlockCache::MarkdownDocument> mDocuments;
+        // Keys of mDocuments, by address and size of the markdown string
+        std::unordered_map<ImGuiID, ImGuiID> mDocumentKeysByAddress;
+        int mLastDocumentsCleanupFrame = -1;
     public:
         MarkdownRenderer(MarkdownOptions markdownOptions)
             : mMarkdownOptions(markdownOptions)
             , mMarkdownCollection(markdownOptions.fontOptions)
+#ifdef CAN_RENDER_IMAGES
+            , mImageCache((size_t)std::max(markdownOptions.imageCacheBudgetMB, 0) * 1024 * 1024)
+#endif
         {
         }
 
 #ifdef CAN_RENDER_IMAGES
-        std::map<std::string, HelloImGui::ImageAndSize >& ImageCache()
+        MarkdownImageCache& ImageCache()
         {
-            return mMarkdownCollection.mLoadedImages;
+            return mImageCache;
         }
 #endif
 
         void Render(const std::string& s)
         {
             ImGui::PushFont(mMarkdownCollection.mFontCollection.GetDefaultFont());
-            const char * start = s.c_str();
-            const char * end = start + s.size();
-            this->print(start, end);
+            if (mMarkdownOptions.withBlockCache)
+                RenderWithBlockCache(s);
+            else
+            {
+                const char * start = s.c_str();
+                const char * end = start + s.size();
+                this->print(start, end);
+            }
+            ImGui::PopFont();
+        }
+
+        void RenderStream(ImGuiMdBlockCache::MarkdownDocument* document)
+        {
+            ImGui::PushFont(mMarkdownCollection.mFontCollection.GetDefaultFont());
+            RenderDocument(document);
             ImGui::PopFont();
         }
 
@@ -246,6 +702,131 @@ assets/
         }
 
     private:
+        ImGuiMdBlockCache::MarkdownDocument* GetDocument(const std::string& s)
+        {
+            // Fast path: the string is at the same address as during the previous frames,
+            // and its content is checked by its size and fingerprint, then by a comparison with the copy
+            // (which is much faster than a hash).
+            ImGuiID idScope = ImGui::GetID("##MarkdownBlockCache");
+            const char* address = s.data();
+            size_t size = s.size();
+            ImGuiID addressKey = ImHashData(&address, sizeof(address), ImHashData(&size, sizeof(size), idScope));
+            ImGuiID fingerprint = ImGuiMdBlockCache::SourceFingerprint(s);
+            auto itKey = mDocumentKeysByAddress.find(addressKey);
+            if (itKey != mDocumentKeysByAddress.end())
+            {
+                auto itDocument = mDocuments.find(itKey->second);
+                if (itDocument != mDocuments.end())
+                {
+                    const auto& document = itDocument->second;
+                    if (document.source.size() == size && document.sourceFingerprint == fingerprint && document.source == s)
+                        return &itDocument->second;
+                }
+            }
+
+            ImGuiID contentKey = ImHashData(s.data(), s.size(), idScope);
+            mDocumentKeysByAddress[addressKey] = contentKey;
+            auto& document = mDocuments[contentKey];
+            if (document.lastFrame < 0 || document.sourceFingerprint != fingerprint || document.source != s)
+            {
+                document = ImGuiMdBlockCache::MarkdownDocument();
+                document.source = s;
+                document.sourceFingerprint = fingerprint;
+                document.blocks = ImGuiMdBlockCache::SplitBlocks(s);
+            }
+            return &document;
+        }
+
+        // Renders a block, and returns true if its height changed
+        bool RenderBlock(ImGuiMdBlockCache::MarkdownBlock* block)
+        {
+            float y = ImGui::GetCursorPosY();
+            const char* start = block->source.c_str();
+            this->print(start, start + block->source.size());
+            float height = ImGui::GetCursorPosY() - y;
+            bool changed = (height != block->height);
+            block->height = height;
+            return changed;
+        }
+
+        void RenderWithBlockCache(const std::string& s)
+        {
+            int frame = ImGui::GetFrameCount();
+            RemoveUnusedDocuments(frame);
+
+            ImGuiMdBlockCache::MarkdownDocument* document = GetDocument(s);
+            document->lastFrame = frame;
+            RenderDocument(document);
+        }
+
+        void RenderDocument(ImGuiMdBlockCache::MarkdownDocument* document)
+        {
+            auto& blocks = document->blocks;
+
+            // All the blocks are measured again when the layout changes
+            float width = ImGui::GetContentRegionAvail().x;
+            float fontSize = ImGui::GetFontSize();
+            if (width != document->width || fontSize != document->fontSize)
+            {
+                document->width = width;
+                document->fontSize = fontSize;
+                ImGuiMdBlockCache::InvalidateBlockTops(document, 0);
+            }
+
+            // The visible measured blocks are found by a binary search in the prefix sums of the heights,
+            // and the measured blocks before and after them are replaced by one empty space each.
+            const auto& tops = document->blockTops;
+            size_t nbMeasuredBlocks = document->nbMeasuredBlocks;
+            float documentTop = ImGui::GetCursorScreenPos().y;
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            float visibleTop = drawList->GetClipRectMin().y - documentTop;
+            float visibleBottom = drawList->GetClipRectMax().y - documentTop;
+            // first visible block: the first block whose bottom is below visibleTop
+            size_t firstVisible = (size_t)(std::upper_bound(tops.begin() + 1, tops.end(), visibleTop) - (tops.begin() + 1));
+            // end of the visible blocks: the first block whose top is below visibleBottom
+            size_t endVisible = (size_t)(std::lower_bound(
+                tops.begin() + (std::ptrdiff_t)firstVisible, tops.begin() + (std::ptrdiff_t)nbMeasuredBlocks, visibleBottom) - tops.begin());
+
+            ImGuiMdBlockCache::AddVerticalSpace(tops[firstVisible]);
+            size_t firstChangedBlock = nbMeasuredBlocks;
+            for (size_t i = firstVisible; i < endVisible; ++i)
+            {
+                // A visible block may change its height (e.g. when an image is loaded)
+                if (RenderBlock(&blocks[i]))
+                    firstChangedBlock = std::min(firstChangedBlock, i);
+            }
+            ImGuiMdBlockCache::AddVerticalSpace(tops[nbMeasuredBlocks] - tops[endVisible]);
+
+            // The blocks which were not measured yet are rendered
+            for (size_t i = nbMeasuredBlocks; i < blocks.size(); ++i)
+                RenderBlock(&blocks[i]);
+
+            if (firstChangedBlock < blocks.size())
+                ImGuiMdBlockCache::UpdateBlockTops(document, firstChangedBlock);
+        }
+
+        // Forgets the documents which were not rendered during the last 60 frames
+        void RemoveUnusedDocuments(int frame)
+        {
+            if (frame == mLastDocumentsCleanupFrame)
+                return;
+            mLastDocumentsCleanupFrame = frame;
+            for (auto it = mDocuments.begin(); it != mDocuments.end(); )
+            {
+                if (it->second.lastFrame < frame - 60)
+                    it = mDocuments.erase(it);
+                else
+                    ++it;
+            }
+            for (auto it = mDocumentKeysByAddress.begin(); it != mDocumentKeysByAddress.end(); )
+            {
+                if (mDocuments.find(it->second) == mDocuments.end())
+                    it = mDocumentKeysByAddress.erase(it);
+                else
+                    ++it;
+            }
+        }
+
         ImFont* get_font() const override
         {
             if (m_is_code)
@@ -364,9 +945,15 @@ assets/
     // Global options
     MarkdownOptions gMarkdownOptions;
 
+    // Lazy font loading state
+    bool gLazyFontLoading = false;
+    bool gLazyFontLoadingRequested = false;
+
     void DeInitializeMarkdown()
     {
-        gMarkdownRenderer.release();
+        gMarkdownRenderer.reset();
+        gLazyFontLoading = false;
+        gLazyFontLoadingRequested = false;
     }
 
     void InitializeMarkdown(const MarkdownOptions& options)
@@ -384,16 +971,6 @@ assets/
     }
 
 
-    void Render(const std::string& markdownString)
-    {
-        if (!gMarkdownRenderer)
-        {
-            std::cerr << "ImGuiMd::Render : Markdown was not initialized!\n";
-            return;
-        }
-        gMarkdownRenderer->Render(markdownString);
-    }
-
     std::function<void(void)> GetFontLoaderFunction()
     {
         auto fontLoaderFunction = []()
@@ -403,6 +980,102 @@ assets/
         return fontLoaderFunction;
     }
 
+    void EnableLazyFontLoading()
+    {
+        gLazyFontLoading = true;
+    }
+
+    bool AreFontsLoaded()
+    {
+        return gMarkdownRenderer != nullptr;
+    }
+
+    // Asks HelloImGui to load the fonts at the next frame boundary (once)
+    static void RequestLazyFontLoading()
+    {
+        if (gLazyFontLoadingRequested)
+            return;
+        auto runnerParams = HelloImGui::GetRunnerParams();
+        if (runnerParams == nullptr)
+            return;
+        auto& loadAdditionalFonts = runnerParams->callbacks.LoadAdditionalFonts;
+        if (loadAdditionalFonts)
+            loadAdditionalFonts = HelloImGui::SequenceFunctions(loadAdditionalFonts, GetFontLoaderFunction());
+        else
+            loadAdditionalFonts = GetFontLoaderFunction();
+        gLazyFontLoadingRequested = true;
+    }
+
+    // Returns true if the renderer can be used (otherwise, the lazy font loading may be requested)
+    static bool IsRendererReady(const char* functionName)
+    {
+        if (gMarkdownRenderer)
+            return true;
+        if (gLazyFontLoading)
+            RequestLazyFontLoading();
+        else
+            std::cerr << functionName << " : Markdown was not initialized!\n";
+        return false;
+    }
+
+    void Render(const std::string& markdownString)
+    {
+        if (!IsRendererReady("ImGuiMd::Render"))
+            return;
+        gMarkdownRenderer->Render(markdownString);
+    }
+
+
+    struct MarkdownStreamData
+    {
+        std::string text;
+        ImGuiMdBlockCache::BlockSplitter splitter;
+        ImGuiMdBlockCache::MarkdownDocument document;
+    };
+
+    MarkdownStream::MarkdownStream()
+        : mData(std::make_unique<MarkdownStreamData>())
+    {
+    }
+
+    MarkdownStream::~MarkdownStream() = default;
+
+    void MarkdownStream::Append(const std::string& text)
+    {
+        auto& data = *mData;
+        auto& blocks = data.document.blocks;
+        size_t previousReferencesSize = data.splitter.linkReferenceDefinitions.size();
+        data.text += text;
+        data.splitter.Scan(data.text, false);
+
+        // Only the last block may have grown, and new blocks may follow it: they will be measured again.
+        size_t firstUpdatedBlock = blocks.empty() ? 0 : blocks.size() - 1;
+        ImGuiMdBlockCache::InvalidateBlockTops(&data.document, firstUpdatedBlock);
+        // New link reference definitions are appended to all the blocks (this does not change their heights)
+        if (data.splitter.linkReferenceDefinitions.size() != previousReferencesSize)
+            firstUpdatedBlock = 0;
+        blocks.resize(data.splitter.blockStarts.size());
+        for (size_t i = firstUpdatedBlock; i < blocks.size(); ++i)
+            blocks[i].source = data.splitter.BlockSource(data.text, i);
+    }
+
+    void MarkdownStream::Clear()
+    {
+        *mData = MarkdownStreamData();
+    }
+
+    const std::string& MarkdownStream::GetText() const
+    {
+        return mData->text;
+    }
+
+    void MarkdownStream::Render()
+    {
+        if (!IsRendererReady("ImGuiMd::MarkdownStream::Render"))
+            return;
+        gMarkdownRenderer->RenderStream(&mData->document);
+    }
+
 
     void OnOpenLink_Default(const std::string& url)
     {
@@ -425,27 +1098,35 @@ assets/
         }
 
         auto & imageCache = gMarkdownRenderer->ImageCache();
-        if (imageCache.find(image_path) == imageCache.end())
+        MarkdownImageCache::ImageInfo imageInfo = imageCache.GetImage(image_path);
+        if (imageInfo.status == MarkdownImageCache::ImageStatus::Failed)
         {
-            std::string errorImage = "images/markdown_broken_image.png";
-            if (HelloImGui::AssetExists(image_path))
-                imageCache[image_path] = HelloImGui::ImageAndSizeFromAsset(image_path.c_str());
-            else if (HelloImGui::AssetExists(errorImage))
-                    imageCache[image_path] = HelloImGui::ImageAndSizeFromAsset(errorImage.c_str());
-            else
+            imageInfo = imageCache.GetImage("images/markdown_broken_image.png");
+            if (imageInfo.status == MarkdownImageCache::ImageStatus::Failed)
                 return std::nullopt;
         }
 
-        const auto& imageInfo = imageCache.at(image_path);
-
         MarkdownImage r;
-
-        r.texture_id = imageInfo.textureId;
-        r.size = imageInfo.size;
         r.uv0 = { 0,0 };
         r.uv1 = {1,1};
         r.col_tint = { 1,1,1,1 };
         r.col_border = { 0,0,0,0 };
+        if (imageInfo.status == MarkdownImageCache::ImageStatus::Ready)
+        {
+            r.texture_id = imageInfo.textureId;
+            r.size = imageInfo.size;
+        }
+        else
+        {
+            // Placeholder while the image is loading: the white pixel of the font atlas, tinted.
+            // Its size is known as soon as the image header was read.
+            ImFontAtlas* fontAtlas = ImGui::GetIO().Fonts;
+            r.texture_id = fontAtlas->TexID;
+            r.uv0 = r.uv1 = fontAtlas->TexUvWhitePixel;
+            r.col_tint = ImGui::GetStyleColorVec4(ImGuiCol_FrameBg);
+            bool isSizeKnown = imageInfo.size.x > 0.f && imageInfo.size.y > 0.f;
+            r.size = isSizeKnown ? imageInfo.size : ImVec2(ImGui::GetFontSize(), ImGui::GetFontSize());
+        }
         return r;
 #else
         return std::nullopt;
@@ -454,13 +1135,31 @@ assets/
 
     ImFont* GetCodeFont()
     {
+        if (!gMarkdownRenderer)
+        {
+            if (gLazyFontLoading)
+                RequestLazyFontLoading();
+            return nullptr;
+        }
         return gMarkdownRenderer->get_font_code();
     }
 
+    MarkdownImageCacheStats GetImageCacheStats()
+    {
+#ifdef CAN_RENDER_IMAGES
+        if (gMarkdownRenderer)
+            return gMarkdownRenderer->ImageCache().GetStats();
+#endif
+        return MarkdownImageCacheStats();
+    }
+
     // Renders a markdown string (after having unindented its main indentation)
     void RenderUnindented(const std::string& markdownString)
     {
-        Render(CodeUtils::UnindentMarkdown(markdownString));
+        // RenderUnindented is usually called at each frame: the buffer is reused, so that it does not reallocate
+        static std::string unindentedBuffer;
+        CodeUtils::UnindentInto(markdownString, true, &unindentedBuffer);
+        Render(unindentedBuffer);
     }
 
 } // namespace ImGuiMdBrowser
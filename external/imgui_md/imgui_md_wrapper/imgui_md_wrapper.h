@@ -18,6 +18,17 @@ namespace ImGuiMd
         int maxHeaderLevel = 2;
         float sizeDiffBetweenLevels = 2.f;
         float regularSize = 16.f;
+
+        // If scaleHeaderFonts is true, only one header font (at the largest header size) is loaded
+        // per emphasis variant, and the smaller header levels are rendered by scaling it down.
+        // This keeps the font atlas small when maxHeaderLevel is large
+        // (at the cost of slightly less crisp small headers).
+        bool scaleHeaderFonts = false;
+
+        // If lazyLoadRareFonts is true, the rarely used font variants (bold italic text, bold or italic headers)
+        // are loaded only when a document first uses them, at the next frame boundary (HelloImGui only).
+        // Until then, the same text with less emphasis is displayed. This keeps the font atlas smaller.
+        bool lazyLoadRareFonts = false;
     };
 
 
@@ -82,6 +93,34 @@ namespace ImGuiMd
     {
         MarkdownFontOptions fontOptions;
         MarkdownCallbacks callbacks;
+
+        // If withBlockCache is true, Render() splits each markdown string into its top-level blocks
+        // (paragraphs, lists, tables, code blocks...) once, and remembers the height of each block:
+        // only the visible blocks are rendered, the others are replaced by an empty space (so that a long document scrolls as fast as a short one).
+        // All the blocks are rendered again when the available width or the font size change, in order to measure them.
+        // (html blocks such as divs are never split, so that OnHtmlDiv calls stay paired, and neither are loose lists)
+        bool withBlockCache = false;
+
+        // The images displayed by OnImage_Default are read and decoded by a worker thread
+        // (a placeholder of the right size is displayed in the meantime).
+        // Their textures (and the decoded images which wait for their upload) are kept in a cache whose memory
+        // is limited to imageCacheBudgetMB: when it is exceeded, the least recently displayed images are evicted,
+        // except those displayed during the last 60 frames.
+        int imageCacheBudgetMB = 256;
+    };
+
+
+    // Statistics of the image cache used by OnImage_Default
+    struct MarkdownImageCacheStats
+    {
+        int nbTextures = 0;             // Number of textures in the cache
+        size_t textureBytes = 0;        // Memory used by these textures
+        size_t budgetBytes = 0;
+        int nbPendingImages = 0;        // Images being read and decoded
+        size_t decodedBytes = 0;        // Memory used by the decoded images which wait for their upload (counts toward the budget)
+        int nbUploadedImages = 0;       // Total number of images uploaded as textures
+        int nbEvictedImages = 0;        // Total number of images evicted from the cache
+        int nbFailedImages = 0;         // Images which could not be read or decoded
     };
 
     // InitializeMarkdown: Call this once at application startup
@@ -100,11 +139,22 @@ namespace ImGuiMd
     //
     //        hello_imgui.run(runner_params)
     void InitializeMarkdown(const MarkdownOptions& options = MarkdownOptions());
+    // DeInitializeMarkdown: destroys the renderer and the textures of its images:
+    // call it while OpenGL is still initialized (e.g. in callbacks.BeforeExit). ImmApp::Run does this automatically.
     void DeInitializeMarkdown();
 
     // GetFontLoaderFunction() will return a function that you should call during ImGui initialization.
     VoidFunction GetFontLoaderFunction();
 
+    // EnableLazyFontLoading: (HelloImGui only) instead of loading the fonts at startup via GetFontLoaderFunction(),
+    // you may call this after InitializeMarkdown(): the fonts will then be loaded at the next frame boundary
+    // after the first call to Render() or GetCodeFont().
+    // Until the fonts are loaded, Render() displays nothing and GetCodeFont() returns nullptr.
+    void EnableLazyFontLoading();
+
+    // AreFontsLoaded returns true once the markdown fonts are loaded
+    bool AreFontsLoaded();
+
     // Renders a markdown string
     void Render(const std::string& markdownString);
 
@@ -112,4 +162,34 @@ namespace ImGuiMd
     void RenderUnindented(const std::string& markdownString);
 
     ImFont* GetCodeFont();
+
+    // GetImageCacheStats: statistics of the image cache used by OnImage_Default (see MarkdownOptions.imageCacheBudgetMB)
+    MarkdownImageCacheStats GetImageCacheStats();
+
+
+    struct MarkdownStreamData;
+
+    // MarkdownStream: renders a markdown text which grows over time (job reports, streamed outputs, logs...)
+    // Calling Render() on an ever-longer string costs O(total length) at each frame. Instead, Append() only scans
+    // the new text from the last block boundary, and Render() reuses the heights of the completed blocks:
+    // only the visible blocks and the last block (which may still grow) are rendered.
+    // (the text is split into blocks as with MarkdownOptions.withBlockCache)
+    class MarkdownStream
+    {
+    public:
+        MarkdownStream();
+        ~MarkdownStream();
+
+        // Appends some markdown text (which may end in the middle of a line)
+        void Append(const std::string& text);
+        // Removes all the text
+        void Clear();
+        const std::string& GetText() const;
+
+        // Renders the text (InitializeMarkdown must have been called, as for Render)
+        void Render();
+
+    private:
+        std::unique_ptr<MarkdownStreamData> mData;
+    };
 }
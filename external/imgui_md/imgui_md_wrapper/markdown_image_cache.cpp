@@ -0,0 +1,309 @@
+// Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#ifdef HELLOIMGUI_HAS_OPENGL // Image rendering with markdown only works with OpenGl
+#include "markdown_image_cache.h"
+#include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/hello_imgui_include_opengl.h"
+#include "imgui.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define IMGUI_MD_IMAGES_NO_THREADS
+#endif
+
+
+namespace ImGuiMd
+{
+    // Uploading a large image takes a few milliseconds: only a few are uploaded per frame
+    static constexpr int kMaxUploadsPerFrame = 2;
+    // An image displayed during the last frames is likely to be displayed again: it is not evicted
+    static constexpr int kNbFramesBeforeEviction = 60;
+
+    struct MarkdownImageCache::Job
+    {
+        std::string assetPath;
+        bool isFileRead = false;                // Only used by the thread which processes the job
+        std::vector<unsigned char> fileData;
+
+        // Guarded by mMutex
+        int width = 0, height = 0;
+        std::vector<unsigned char> pixels;      // RGBA
+        bool isDecoded = false;
+        bool hasFailed = false;
+        bool isCancelled = false;               // The entry was dropped: the job result is discarded
+    };
+
+
+    static ImTextureID UploadTexture(const unsigned char* rgbaPixels, int width, int height)
+    {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return (ImTextureID)(size_t)texture;
+    }
+
+    static void DeleteTexture(ImTextureID textureId)
+    {
+        GLuint texture = (GLuint)((uintptr_t)textureId);
+        glDeleteTextures(1, &texture);
+    }
+
+
+    MarkdownImageCache::MarkdownImageCache(size_t budgetBytes)
+        : mBudgetBytes(budgetBytes)
+    {
+        mStats.budgetBytes = budgetBytes;
+#ifndef IMGUI_MD_IMAGES_NO_THREADS
+        mWorker = std::thread([this]() { WorkerLoop(); });
+#endif
+    }
+
+    MarkdownImageCache::~MarkdownImageCache()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopRequested = true;
+        }
+        mCondition.notify_all();
+        if (mWorker.joinable())
+            mWorker.join();
+
+        for (const auto& kv: mEntries)
+            if (kv.second.info.status == ImageStatus::Ready)
+                DeleteTexture(kv.second.info.textureId);
+    }
+
+
+    // Reads the file and its header (first step), or decodes it (second step)
+    void MarkdownImageCache::ProcessJob(const std::shared_ptr<Job>& job)
+    {
+        int width = 0, height = 0, nbComponents = 0;
+        if (!job->isFileRead)
+        {
+            job->isFileRead = true;
+            if (HelloImGui::AssetExists(job->assetPath))
+            {
+                HelloImGui::AssetFileData fileData = HelloImGui::LoadAssetFileData(job->assetPath.c_str());
+                const unsigned char* bytes = (const unsigned char*)fileData.data;
+                job->fileData.assign(bytes, bytes + fileData.dataSize);
+                HelloImGui::FreeAssetFileData(&fileData);
+            }
+            bool isValid = !job->fileData.empty()
+                && stbi_info_from_memory(job->fileData.data(), (int)job->fileData.size(), &width, &height, &nbComponents) != 0;
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            job->width = width;
+            job->height = height;
+            job->hasFailed = !isValid;
+            if (isValid && !job->isCancelled)
+                mJobsToDecode.push_back(job);
+        }
+        else
+        {
+            std::vector<unsigned char> rgbaPixels;
+            unsigned char* pixels = stbi_load_from_memory(
+                job->fileData.data(), (int)job->fileData.size(), &width, &height, &nbComponents, 4);
+            if (pixels != nullptr)
+            {
+                rgbaPixels.assign(pixels, pixels + (size_t)width * (size_t)height * 4);
+                stbi_image_free(pixels);
+            }
+            job->fileData = std::vector<unsigned char>();
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (job->isCancelled)
+                return;
+            job->hasFailed = (pixels == nullptr);
+            job->isDecoded = (pixels != nullptr);
+            job->pixels = std::move(rgbaPixels);
+            mDecodedBytes += job->pixels.size();
+        }
+    }
+
+    void MarkdownImageCache::WorkerLoop()
+    {
+        while (true)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() {
+                    return mStopRequested || !mJobsToRead.empty() || !mJobsToDecode.empty();
+                });
+                if (mStopRequested)
+                    return;
+                auto& jobs = mJobsToRead.empty() ? mJobsToDecode : mJobsToRead;
+                job = jobs.front();
+                jobs.pop_front();
+            }
+            ProcessJob(job);
+        }
+    }
+
+
+    MarkdownImageCache::ImageInfo MarkdownImageCache::GetImage(const std::string& assetPath)
+    {
+        int frame = ImGui::GetFrameCount();
+        if (frame != mEvictionFrame)
+        {
+            mEvictionFrame = frame;
+            EvictOverBudget(frame);
+        }
+
+#ifdef IMGUI_MD_IMAGES_NO_THREADS
+        // Without threads, one job step is processed per frame
+        if (frame != mLastSyncJobFrame)
+        {
+            mLastSyncJobFrame = frame;
+            auto& jobs = mJobsToRead.empty() ? mJobsToDecode : mJobsToRead;
+            if (!jobs.empty())
+            {
+                std::shared_ptr<Job> job = jobs.front();
+                jobs.pop_front();
+                ProcessJob(job);
+            }
+        }
+#endif
+
+        auto it = mEntries.find(assetPath);
+        if (it == mEntries.end())
+        {
+            Entry entry;
+            entry.job = std::make_shared<Job>();
+            entry.job->assetPath = assetPath;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mJobsToRead.push_back(entry.job);
+            }
+            mCondition.notify_one();
+            it = mEntries.emplace(assetPath, std::move(entry)).first;
+        }
+
+        Entry& entry = it->second;
+        entry.lastUsedFrame = frame;
+        if (entry.job)
+            UpdatePendingEntry(&entry, frame);
+        else if (entry.info.status == ImageStatus::Ready)
+            mLru.splice(mLru.begin(), mLru, entry.lruPosition);
+
+        return entry.info;
+    }
+
+    // Publishes the size of a pending image, and uploads it once it is decoded
+    void MarkdownImageCache::UpdatePendingEntry(Entry* entry, int frame)
+    {
+        if (frame != mUploadsFrame)
+        {
+            mUploadsFrame = frame;
+            mNbUploadsThisFrame = 0;
+        }
+
+        std::vector<unsigned char> pixels;
+        bool isDecoded = false, hasFailed = false;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            entry->info.size = ImVec2((float)entry->job->width, (float)entry->job->height);
+            hasFailed = entry->job->hasFailed;
+            isDecoded = entry->job->isDecoded && mNbUploadsThisFrame < kMaxUploadsPerFrame;
+            if (isDecoded)
+            {
+                pixels = std::move(entry->job->pixels);
+                mDecodedBytes -= pixels.size();
+            }
+        }
+
+        if (hasFailed)
+        {
+            entry->info.status = ImageStatus::Failed;
+            entry->job.reset();
+            ++mStats.nbFailedImages;
+        }
+        else if (isDecoded)
+        {
+            int width = (int)entry->info.size.x, height = (int)entry->info.size.y;
+            entry->info.textureId = UploadTexture(pixels.data(), width, height);
+            entry->info.status = ImageStatus::Ready;
+            entry->textureBytes = pixels.size();
+            mLru.push_front(entry->job->assetPath);
+            entry->lruPosition = mLru.begin();
+            entry->job.reset();
+            ++mNbUploadsThisFrame;
+            ++mStats.nbUploadedImages;
+            mStats.textureBytes += entry->textureBytes;
+        }
+    }
+
+    // Drops the pending images which were not displayed during the last frames (e.g. scrolled past
+    // before their upload), so that their decoded pixels do not stay in memory. They are loaded again if displayed later.
+    void MarkdownImageCache::DropStalePendingEntries(int frame)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto it = mEntries.begin(); it != mEntries.end(); )
+        {
+            Entry& entry = it->second;
+            if (!entry.job || entry.lastUsedFrame >= frame - kNbFramesBeforeEviction)
+            {
+                ++it;
+                continue;
+            }
+            const auto& job = entry.job;
+            job->isCancelled = true;
+            mDecodedBytes -= job->pixels.size();
+            job->pixels = std::vector<unsigned char>();
+            for (auto* jobs: { &mJobsToRead, &mJobsToDecode })
+                jobs->erase(std::remove(jobs->begin(), jobs->end(), job), jobs->end());
+            it = mEntries.erase(it);
+        }
+    }
+
+    // Deletes the least recently displayed textures, while over budget (called at the start of a frame)
+    void MarkdownImageCache::EvictOverBudget(int frame)
+    {
+        size_t decodedBytes;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            decodedBytes = mDecodedBytes;
+        }
+        if (mStats.textureBytes + decodedBytes > mBudgetBytes)
+        {
+            DropStalePendingEntries(frame);
+            std::lock_guard<std::mutex> lock(mMutex);
+            decodedBytes = mDecodedBytes;
+        }
+        while (mStats.textureBytes + decodedBytes > mBudgetBytes && !mLru.empty())
+        {
+            auto it = mEntries.find(mLru.back());
+            if (it->second.lastUsedFrame >= frame - kNbFramesBeforeEviction)
+                break;
+            DeleteTexture(it->second.info.textureId);
+            mStats.textureBytes -= it->second.textureBytes;
+            ++mStats.nbEvictedImages;
+            mLru.pop_back();
+            mEntries.erase(it);
+        }
+    }
+
+    MarkdownImageCacheStats MarkdownImageCache::GetStats() const
+    {
+        MarkdownImageCacheStats r = mStats;
+        r.nbTextures = (int)mLru.size();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            r.decodedBytes = mDecodedBytes;
+        }
+        for (const auto& kv: mEntries)
+            if (kv.second.job)
+                ++r.nbPendingImages;
+        return r;
+    }
+}
+
+#endif // #ifdef HELLOIMGUI_HAS_OPENGL
@@ -0,0 +1,81 @@
+// Part of ImGui Bundle - MIT License - Copyright (c) 2022-2024 Pascal Thomet - https://github.com/pthom/imgui_bundle
+#pragma once
+#include "imgui_md_wrapper.h"
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+
+namespace ImGuiMd
+{
+    // MarkdownImageCache: the images displayed by OnImage_Default (OpenGL only).
+    //
+    // Images are read and decoded by a worker thread, and uploaded as textures by the UI thread
+    // (at most a few per frame). Their size is known as soon as their header was read, so that a placeholder
+    // of the right size can be displayed in the meantime.
+    // The textures are kept in an LRU cache. Once per frame, if budgetBytes is exceeded (the decoded images
+    // which wait for their upload count toward it), the least recently displayed ones are deleted,
+    // but only those which were not displayed during the last few frames. The pending images which were
+    // not displayed during these frames are dropped as well (with their decoded pixels).
+    class MarkdownImageCache
+    {
+    public:
+        enum class ImageStatus { Loading, Ready, Failed };
+
+        struct ImageInfo
+        {
+            ImageStatus status = ImageStatus::Loading;
+            ImTextureID textureId = ImTextureID(0);
+            ImVec2 size = ImVec2(0.f, 0.f);     // (0, 0) until the image header was read
+        };
+
+        explicit MarkdownImageCache(size_t budgetBytes);
+        ~MarkdownImageCache();
+
+        // Returns the current state of an image, and starts loading it if needed (UI thread only)
+        ImageInfo GetImage(const std::string& assetPath);
+
+        MarkdownImageCacheStats GetStats() const;
+
+    private:
+        struct Job;
+        struct Entry
+        {
+            ImageInfo info;
+            std::shared_ptr<Job> job;                   // Until the image is uploaded or has failed
+            size_t textureBytes = 0;
+            int lastUsedFrame = -1;
+            std::list<std::string>::iterator lruPosition;  // Valid when a texture was uploaded
+        };
+
+        void UpdatePendingEntry(Entry* entry, int frame);
+        void DropStalePendingEntries(int frame);
+        void EvictOverBudget(int frame);
+        void ProcessJob(const std::shared_ptr<Job>& job);
+        void WorkerLoop();
+
+        size_t mBudgetBytes;
+        std::unordered_map<std::string, Entry> mEntries;
+        std::list<std::string> mLru;                    // Paths of the uploaded images, most recently displayed first
+        MarkdownImageCacheStats mStats;
+        int mEvictionFrame = -1;
+        int mUploadsFrame = -1;
+        int mNbUploadsThisFrame = 0;
+        int mLastSyncJobFrame = -1;                     // Used when threads are not available
+
+        // Shared with the worker thread
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<std::shared_ptr<Job>> mJobsToRead;     // Reading the header comes first, so that sizes are known early
+        std::deque<std::shared_ptr<Job>> mJobsToDecode;
+        size_t mDecodedBytes = 0;                       // Pixels of the decoded images, until their upload
+        bool mStopRequested = false;
+        std::thread mWorker;
+    };
+}
@@ -0,0 +1,152 @@
+// Compares CodeUtils::Unindent with its previous implementation (based on fplus), on large inputs.
+// The outputs are checked to be identical before timing.
+#include "immapp/code_utils.h"
+#include <fplus/fplus.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+
+namespace CodeUtilsFplus
+{
+    using Lines = std::vector<std::string>;
+    using String = std::string;
+
+    bool IsSpaceOrEmpty(const String& s)
+    {
+        return fplus::trim_whitespace(s).size() == 0;
+    }
+
+    Lines StripEmptyLinesInList(const Lines& code_lines)
+    {
+        Lines r;
+        r = fplus::drop_while(IsSpaceOrEmpty, code_lines);
+        r = fplus::reverse(r);
+        r = fplus::drop_while(IsSpaceOrEmpty, r);
+        r = fplus::reverse(r);
+        return r;
+    }
+
+    String StripEmptyLines(const String& s)
+    {
+        auto lines = fplus::split_lines(true, s);
+        auto lines_stripped = StripEmptyLinesInList(lines);
+        return fplus::join(std::string("\n"), lines_stripped);
+    }
+
+    int CountSpacesAtStartOfLine(const String& line)
+    {
+        int nbSpacesthisLine = 0;
+        for (auto c : line)
+            if (c == ' ')
+                ++nbSpacesthisLine;
+            else
+                return nbSpacesthisLine;
+        return nbSpacesthisLine;
+    }
+
+    int ComputeCodeIndentSize(const String& code)
+    {
+        auto lines = fplus::split_lines(true, code);
+        for (const auto& line: lines)
+        {
+            if (IsSpaceOrEmpty(line))
+                continue;
+            return CountSpacesAtStartOfLine(line);
+        }
+        return 0;
+    }
+
+    std::string Unindent(const std::string& code, bool is_markdown)
+    {
+        int indentSize = ComputeCodeIndentSize(code);
+        String whatToReplace(indentSize, ' ');
+        auto lines = fplus::split_lines(true, code);
+
+        Lines processedLines;
+        for (const auto& line: lines)
+        {
+            String processedLine;
+            if (fplus::is_prefix_of(whatToReplace, line))
+                processedLine = fplus::drop(indentSize, line);
+            else
+                processedLine = line;
+
+            if (is_markdown)
+                processedLines.push_back(processedLine + " ");
+            else
+                processedLines.push_back(fplus::trim_right(' ', processedLine));
+        }
+
+        String r = fplus::join(std::string("\n"), processedLines);
+        return StripEmptyLines(r);
+    }
+} // namespace CodeUtilsFplus
+
+
+std::string MakeRandomCode(size_t nbLines, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    const char* fragments[] = { "int", "x", "=", "foo(bar);", "// comment", "\t", "  ", "return", "{", "}" };
+    const char* lineBreaks[] = { "\n", "\n", "\n", "\n", "\r\n", "\r" };
+    std::string r;
+    for (size_t i = 0; i < nbLines; ++i)
+    {
+        int indent = 4 + (int)(rng() % 4) * 4;
+        if (rng() % 10 == 0)
+            indent = (int)(rng() % 4); // lines with a smaller indentation, and blank lines
+        r.append((size_t)indent, ' ');
+        int nbFragments = (int)(rng() % 8);
+        for (int j = 0; j < nbFragments; ++j)
+        {
+            r += fragments[rng() % 10];
+            r += ' ';
+        }
+        r += lineBreaks[rng() % 6];
+    }
+    return r;
+}
+
+
+template<typename F>
+double TimeMs(int nbRuns, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nbRuns; ++i)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / nbRuns;
+}
+
+
+int main()
+{
+    // Check that both implementations give the same results
+    for (unsigned seed = 0; seed < 2000; ++seed)
+    {
+        std::string code = MakeRandomCode(seed % 40, seed);
+        for (bool isMarkdown: { false, true })
+        {
+            if (CodeUtils::Unindent(code, isMarkdown) != CodeUtilsFplus::Unindent(code, isMarkdown))
+            {
+                printf("Mismatch for seed %u (is_markdown=%d)\n", seed, (int)isMarkdown);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    printf("%12s %12s %14s %14s %14s\n", "lines", "bytes", "fplus (ms)", "string_view", "into buffer");
+    for (size_t nbLines: { 100, 10000, 100000, 1000000 })
+    {
+        std::string code = MakeRandomCode(nbLines, 42);
+        int nbRuns = nbLines <= 10000 ? 50 : 3;
+        std::string buffer;
+        double msFplus = TimeMs(nbRuns, [&]() { CodeUtilsFplus::Unindent(code, false); });
+        double msNew = TimeMs(nbRuns, [&]() { CodeUtils::UnindentCode(code); });
+        double msInto = TimeMs(nbRuns, [&]() { CodeUtils::UnindentInto(code, false, &buffer); });
+        printf("%12zu %12zu %14.3f %14.3f %14.3f\n", nbLines, code.size(), msFplus, msNew, msInto);
+    }
+    return EXIT_SUCCESS;
+}
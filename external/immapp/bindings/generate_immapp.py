@@ -28,12 +28,21 @@ def main():
 
     options.fn_return_force_policy_reference_for_references__regex = r".*"
     options.fn_return_force_policy_reference_for_pointers__regex = r".*"
+    # UnindentInto writes into a C++ buffer: python uses Unindent
+    options.fn_exclude_by_name__regex = r"^UnindentInto$"
 
     generator = litgen.LitgenGenerator(options)
     generator.process_cpp_file(CPP_HEADERS_DIR + "/immapp.h")
     generator.process_cpp_file(CPP_HEADERS_DIR + "/immapp_widgets.h")
     generator.process_cpp_file(CPP_HEADERS_DIR + "/runner.h")
     generator.process_cpp_file(CPP_HEADERS_DIR + "/clock.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/frame_timings.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/redraw.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/startup_timeline.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/font_atlas_cache.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/font_atlas_parallel_build.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/dynamic_glyphs.h")
+    generator.process_cpp_file(CPP_HEADERS_DIR + "/font_atlas_async_rebuild.h")
     generator.process_cpp_file(CPP_HEADERS_DIR + "/code_utils.h")
     generator.process_cpp_file(CPP_HEADERS_DIR + "/snippets.h")
 
@@ -95,7 +95,7 @@ void py_init_module_immapp_cpp(py::module& m)
         py::class_<ImmApp::AddOnsParams>
             (m, "AddOnsParams", "///////////////////////////////////////////////////////////////////////////////////////\n\n AddOnParams: require specific ImGuiBundle packages (markdown, node editor, texture viewer)\n to be initialized at startup.\n\n/////////////////////////////////////////////////////////////////////////////////////")
         .def(py::init<>([](
-        bool withImplot = false, bool withMarkdown = false, bool withNodeEditor = false, bool withTexInspect = false, std::optional<NodeEditorConfig> withNodeEditorConfig = std::nullopt, std::optional<ImGuiMd::MarkdownOptions> withMarkdownOptions = std::nullopt)
+        bool withImplot = false, bool withMarkdown = false, bool withNodeEditor = false, bool withTexInspect = false, std::optional<NodeEditorConfig> withNodeEditorConfig = std::nullopt, std::optional<ImGuiMd::MarkdownOptions> withMarkdownOptions = std::nullopt, bool withFrameTimings = false, bool withLazyInit = false, bool withFontAtlasCache = false, bool withParallelFontBuild = false, bool withAsyncFontRebuild = false)
         {
             auto r = std::make_unique<ImmApp::AddOnsParams>();
             r->withImplot = withImplot;
@@ -104,9 +104,14 @@ void py_init_module_immapp_cpp(py::module& m)
             r->withTexInspect = withTexInspect;
             r->withNodeEditorConfig = withNodeEditorConfig;
             r->withMarkdownOptions = withMarkdownOptions;
+            r->withFrameTimings = withFrameTimings;
+            r->withLazyInit = withLazyInit;
+            r->withFontAtlasCache = withFontAtlasCache;
+            r->withParallelFontBuild = withParallelFontBuild;
+            r->withAsyncFontRebuild = withAsyncFontRebuild;
             return r;
         })
-        , py::arg("with_implot") = false, py::arg("with_markdown") = false, py::arg("with_node_editor") = false, py::arg("with_tex_inspect") = false, py::arg("with_node_editor_config") = py::none(), py::arg("with_markdown_options") = py::none()
+        , py::arg("with_implot") = false, py::arg("with_markdown") = false, py::arg("with_node_editor") = false, py::arg("with_tex_inspect") = false, py::arg("with_node_editor_config") = py::none(), py::arg("with_markdown_options") = py::none(), py::arg("with_frame_timings") = false, py::arg("with_lazy_init") = false, py::arg("with_font_atlas_cache") = false, py::arg("with_parallel_font_build") = false, py::arg("with_async_font_rebuild") = false
         )
         .def_readwrite("with_implot", &ImmApp::AddOnsParams::withImplot, "Set withImplot=True if you need to plot graphs")
         .def_readwrite("with_markdown", &ImmApp::AddOnsParams::withMarkdown, " Set withMarkdown=True if you need to render Markdown\n (alternatively, you can set withMarkdownOptions)")
@@ -118,6 +123,11 @@ void py_init_module_immapp_cpp(py::module& m)
         // #endif
         //
         .def_readwrite("with_markdown_options", &ImmApp::AddOnsParams::withMarkdownOptions, "You can tweak MarkdownOptions (but this is optional)")
+        .def_readwrite("with_frame_timings", &ImmApp::AddOnsParams::withFrameTimings, " Set withFrameTimings=True to record the time spent in each phase of the frames\n (see frame_timings.h: GetFrameTimingsStats(), ShowFrameTimingsWindow())")
+        .def_readwrite("with_lazy_init", &ImmApp::AddOnsParams::withLazyInit, " Set withLazyInit=True to initialize the addons on first use, instead of at startup:\n   - the markdown fonts are loaded at the next frame boundary after the first call to ImGuiMd::Render()\n     (nothing is displayed during that frame)\n   - the node editor context is created by the first call to DefaultNodeEditorContext()\n     (call it before using ax::NodeEditor)\n This reduces the startup time of apps which do not always use these addons.\n (ImPlot and ImGuiTexInspect contexts are cheap to create, and are still created at startup)")
+        .def_readwrite("with_font_atlas_cache", &ImmApp::AddOnsParams::withFontAtlasCache, " Set withFontAtlasCache=True to save the baked font atlas to disk, and reload it at the next launches\n instead of rasterizing the fonts again (see font_atlas_cache.h)")
+        .def_readwrite("with_parallel_font_build", &ImmApp::AddOnsParams::withParallelFontBuild, " Set withParallelFontBuild=True to rasterize the independent fonts on several threads\n when the font atlas is built (see font_atlas_parallel_build.h)")
+        .def_readwrite("with_async_font_rebuild", &ImmApp::AddOnsParams::withAsyncFontRebuild, " Set withAsyncFontRebuild=True to rebuild the font atlas on a worker thread when the fonts\n are reloaded after startup (e.g. after a DPI change), instead of freezing the UI\n (see font_atlas_async_rebuild.h)")
         ;
 
 
@@ -137,6 +147,30 @@ void py_init_module_immapp_cpp(py::module& m)
         py::arg("gui_function"), py::arg("window_title") = "", py::arg("window_size_auto") = false, py::arg("window_restore_previous_geometry") = false, py::arg("window_size") = DefaultWindowSize, py::arg("fps_idle") = 10.f, py::arg("with_implot") = false, py::arg("with_node_editor") = false, py::arg("with_tex_inspect") = false, py::arg("with_node_editor_config") = py::none(), py::arg("with_markdown_options") = py::none(),
         "Run an application with markdown");
 
+
+    auto pyClassNullBackendParams =
+        py::class_<ImmApp::NullBackendParams>
+            (m, "NullBackendParams", "///////////////////////////////////////////////////////////////////////////////////////\n\n Headless runs, with HelloImGui's Null backend (no window, no GPU)\n\n/////////////////////////////////////////////////////////////////////////////////////")
+        .def(py::init<>([](
+        int nbFrames = 60, float fixedDeltaTime = 1.f / 60.f)
+        {
+            auto r = std::make_unique<ImmApp::NullBackendParams>();
+            r->nbFrames = nbFrames;
+            r->fixedDeltaTime = fixedDeltaTime;
+            return r;
+        })
+        , py::arg("nb_frames") = 60, py::arg("fixed_delta_time") = 1.f / 60.f
+        )
+        .def_readwrite("nb_frames", &ImmApp::NullBackendParams::nbFrames, " Number of frames to render before exiting\n (if 0, the app will run until runnerParams.appShallExit is set to True)")
+        .def_readwrite("fixed_delta_time", &ImmApp::NullBackendParams::fixedDeltaTime, "Fixed time step (in seconds) given to ImGui at each frame")
+        ;
+
+
+    m.def("run_with_null_backend",
+        ImmApp::RunWithNullBackend,
+        py::arg("runner_params"), py::arg("add_ons_params") = ImmApp::AddOnsParams(), py::arg("null_backend_params") = ImmApp::NullBackendParams(),
+        " RunWithNullBackend: runs an application with the Null platform and renderer backends.\n NewFrame/Render are called at each frame, and the resulting ImDrawData is discarded.\n All the RunnerCallbacks are called, and the addons are initialized as with Run().\n This is useful to measure the CPU cost of your gui functions, on machines without display or GPU\n (e.g. CI servers).\n The backends, idling and callbacks of runnerParams are restored after the run: they can be reused for another run.");
+
     m.def("em_size",
         py::overload_cast<>(ImmApp::EmSize), " EmSize() returns the visible font size on the screen. For good results on HighDPI screens, always scale your\n widgets and windows relatively to this size.\n It is somewhat comparable to the [em CSS Unit](https://lyty.dev/css/css-unit.html).\n EmSize() = ImGui::GetFontSize()");
 
@@ -194,6 +228,261 @@ void py_init_module_immapp_cpp(py::module& m)
     ////////////////////    </generated_from:clock.h>    ////////////////////
 
 
+    ////////////////////    <generated_from:frame_timings.h>    ////////////////////
+    py::enum_<ImmApp::FramePhase>(m, "FramePhase", py::arithmetic(), "")
+        .value("pre_new_frame", ImmApp::FramePhase::PreNewFrame, "callbacks.PreNewFrame")
+        .value("show_gui", ImmApp::FramePhase::ShowGui, "callbacks.ShowGui (excluding the dockable windows)")
+        .value("dockable_windows", ImmApp::FramePhase::DockableWindows, "The GuiFunction of all the dockable windows")
+        .value("custom_background", ImmApp::FramePhase::CustomBackground, "callbacks.CustomBackground")
+        .value("before_imgui_render", ImmApp::FramePhase::BeforeImGuiRender, "callbacks.BeforeImGuiRender")
+        .value("render_and_swap", ImmApp::FramePhase::RenderAndSwap, "ImGui::Render + backend rendering + swap buffers (inferred from the surrounding callbacks)")
+        .value("after_swap", ImmApp::FramePhase::AfterSwap, "callbacks.AfterSwap")
+        .value("idle", ImmApp::FramePhase::Idle, "Events polling + idle sleep (time between AfterSwap and the next PreNewFrame)")
+        .value("count", ImmApp::FramePhase::Count, "");
+
+
+    m.def("frame_phase_name",
+        ImmApp::FramePhaseName,
+        py::arg("phase"),
+        "FramePhaseName returns a displayable name for a phase");
+
+
+    auto pyClassFramePhaseStats =
+        py::class_<ImmApp::FramePhaseStats>
+            (m, "FramePhaseStats", "Statistics for a phase, computed on the frames stored in the ring buffer (all durations in milliseconds)")
+        .def(py::init<>([](
+        ImmApp::FramePhase Phase = ImmApp::FramePhase::PreNewFrame, float P50Ms = 0.f, float P95Ms = 0.f, float P99Ms = 0.f, float MeanMs = 0.f, float MaxMs = 0.f)
+        {
+            auto r = std::make_unique<ImmApp::FramePhaseStats>();
+            r->Phase = Phase;
+            r->P50Ms = P50Ms;
+            r->P95Ms = P95Ms;
+            r->P99Ms = P99Ms;
+            r->MeanMs = MeanMs;
+            r->MaxMs = MaxMs;
+            return r;
+        })
+        , py::arg("phase") = ImmApp::FramePhase::PreNewFrame, py::arg("p50_ms") = 0.f, py::arg("p95_ms") = 0.f, py::arg("p99_ms") = 0.f, py::arg("mean_ms") = 0.f, py::arg("max_ms") = 0.f
+        )
+        .def_readwrite("phase", &ImmApp::FramePhaseStats::Phase, "")
+        .def_readwrite("p50_ms", &ImmApp::FramePhaseStats::P50Ms, "")
+        .def_readwrite("p95_ms", &ImmApp::FramePhaseStats::P95Ms, "")
+        .def_readwrite("p99_ms", &ImmApp::FramePhaseStats::P99Ms, "")
+        .def_readwrite("mean_ms", &ImmApp::FramePhaseStats::MeanMs, "")
+        .def_readwrite("max_ms", &ImmApp::FramePhaseStats::MaxMs, "")
+        ;
+
+
+    m.def("get_frame_timings_stats",
+        ImmApp::GetFrameTimingsStats, " GetFrameTimingsStats returns the statistics for each phase (in the order of FramePhase)\n (returns an empty vector if no frame was recorded)");
+
+    m.def("get_frame_timings_history",
+        ImmApp::GetFrameTimingsHistory,
+        py::arg("phase"),
+        "GetFrameTimingsHistory returns the durations (in ms) of a phase, for the recorded frames (oldest first)");
+
+    m.def("get_frame_timings_nb_recorded_frames",
+        ImmApp::GetFrameTimingsNbRecordedFrames, " GetFrameTimingsNbRecordedFrames returns the total number of recorded frames since the app start\n (the ring buffer only keeps the last FrameTimingsCapacity() frames)");
+
+    m.def("frame_timings_capacity",
+        ImmApp::FrameTimingsCapacity);
+
+    m.def("clear_frame_timings",
+        ImmApp::ClearFrameTimings, "ClearFrameTimings clears the ring buffer");
+
+    m.def("show_frame_timings_window",
+        [](std::optional<bool> p_open = std::nullopt) -> std::optional<bool>
+        {
+            auto ShowFrameTimingsWindow_adapt_modifiable_immutable_to_return = [](std::optional<bool> p_open = std::nullopt) -> std::optional<bool>
+            {
+                bool * p_open_adapt_modifiable = nullptr;
+                if (p_open.has_value())
+                    p_open_adapt_modifiable = & (*p_open);
+
+                ImmApp::ShowFrameTimingsWindow(p_open_adapt_modifiable);
+                return p_open;
+            };
+
+            return ShowFrameTimingsWindow_adapt_modifiable_immutable_to_return(p_open);
+        },
+        py::arg("p_open") = py::none(),
+        " ShowFrameTimingsWindow: displays a window with p50/p95/p99 per phase,\n and a plot of the recent history (if ImPlot is available)");
+    ////////////////////    </generated_from:frame_timings.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:redraw.h>    ////////////////////
+    m.def("request_redraw",
+        ImmApp::RequestRedraw, "RequestRedraw: wakes up the application, so that a new frame is rendered as soon as possible.");
+
+    m.def("request_redraw_at",
+        ImmApp::RequestRedrawAt,
+        py::arg("time_seconds"),
+        " RequestRedrawAt: requests that a new frame be rendered at the given time\n (timeSeconds is given in the same unit/origin as ImmApp::ClockSeconds()).");
+
+    m.def("request_redraw_in",
+        ImmApp::RequestRedrawIn,
+        py::arg("delay_seconds"),
+        "RequestRedrawIn: requests that a new frame be rendered after delaySeconds");
+    ////////////////////    </generated_from:redraw.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:startup_timeline.h>    ////////////////////
+    auto pyClassStartupPhase =
+        py::class_<ImmApp::StartupPhase>
+            (m, "StartupPhase", "")
+        .def(py::init<>([](
+        std::string Name = std::string(), double StartSeconds = 0., double WallSeconds = 0., double CpuSeconds = 0.)
+        {
+            auto r = std::make_unique<ImmApp::StartupPhase>();
+            r->Name = Name;
+            r->StartSeconds = StartSeconds;
+            r->WallSeconds = WallSeconds;
+            r->CpuSeconds = CpuSeconds;
+            return r;
+        })
+        , py::arg("name") = std::string(), py::arg("start_seconds") = 0., py::arg("wall_seconds") = 0., py::arg("cpu_seconds") = 0.
+        )
+        .def_readwrite("name", &ImmApp::StartupPhase::Name, "")
+        .def_readwrite("start_seconds", &ImmApp::StartupPhase::StartSeconds, "Start time, relative to the start of ImmApp::Run (in seconds)")
+        .def_readwrite("wall_seconds", &ImmApp::StartupPhase::WallSeconds, "Wall clock duration (in seconds)")
+        .def_readwrite("cpu_seconds", &ImmApp::StartupPhase::CpuSeconds, "CPU time used by the process (all threads) during this phase (in seconds)")
+        ;
+
+
+    auto pyClassStartupTimeline =
+        py::class_<ImmApp::StartupTimeline>
+            (m, "StartupTimeline", "")
+        .def(py::init<>([](
+        std::vector<ImmApp::StartupPhase> Phases = std::vector<ImmApp::StartupPhase>(), double TotalWallSeconds = 0., double TotalCpuSeconds = 0., bool IsComplete = false)
+        {
+            auto r = std::make_unique<ImmApp::StartupTimeline>();
+            r->Phases = Phases;
+            r->TotalWallSeconds = TotalWallSeconds;
+            r->TotalCpuSeconds = TotalCpuSeconds;
+            r->IsComplete = IsComplete;
+            return r;
+        })
+        , py::arg("phases") = std::vector<ImmApp::StartupPhase>(), py::arg("total_wall_seconds") = 0., py::arg("total_cpu_seconds") = 0., py::arg("is_complete") = false
+        )
+        .def_readwrite("phases", &ImmApp::StartupTimeline::Phases, "")
+        .def_readwrite("total_wall_seconds", &ImmApp::StartupTimeline::TotalWallSeconds, "")
+        .def_readwrite("total_cpu_seconds", &ImmApp::StartupTimeline::TotalCpuSeconds, "")
+        .def_readwrite("is_complete", &ImmApp::StartupTimeline::IsComplete, "IsComplete is True once the first frame was displayed")
+        ;
+
+
+    m.def("get_startup_timeline",
+        ImmApp::GetStartupTimeline, "GetStartupTimeline returns the startup timeline of the last call to ImmApp::Run()");
+
+    m.def("startup_timeline_to_chrome_trace",
+        ImmApp::StartupTimelineToChromeTrace,
+        py::arg("timeline"),
+        " StartupTimelineToChromeTrace returns the timeline in the Chrome trace event format\n (can be opened with chrome://tracing, or https://ui.perfetto.dev)");
+
+    m.def("save_startup_timeline_chrome_trace",
+        ImmApp::SaveStartupTimelineChromeTrace,
+        py::arg("filename"),
+        " SaveStartupTimelineChromeTrace saves the current startup timeline as a Chrome trace json file.\n Returns False in case of failure.");
+    ////////////////////    </generated_from:startup_timeline.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:font_atlas_cache.h>    ////////////////////
+    auto pyClassFontAtlasCacheStats =
+        py::class_<ImmApp::FontAtlasCacheStats>
+            (m, "FontAtlasCacheStats", "")
+        .def(py::init<>([](
+        int NbHits = 0, int NbMisses = 0, double LastBuildSeconds = 0.)
+        {
+            auto r = std::make_unique<ImmApp::FontAtlasCacheStats>();
+            r->NbHits = NbHits;
+            r->NbMisses = NbMisses;
+            r->LastBuildSeconds = LastBuildSeconds;
+            return r;
+        })
+        , py::arg("nb_hits") = 0, py::arg("nb_misses") = 0, py::arg("last_build_seconds") = 0.
+        )
+        .def_readwrite("nb_hits", &ImmApp::FontAtlasCacheStats::NbHits, "Number of atlas builds served from the cache")
+        .def_readwrite("nb_misses", &ImmApp::FontAtlasCacheStats::NbMisses, "Number of atlas builds which required a rasterization")
+        .def_readwrite("last_build_seconds", &ImmApp::FontAtlasCacheStats::LastBuildSeconds, "Duration of the last atlas build (in seconds), whether from the cache or not")
+        ;
+
+
+    m.def("install_font_atlas_cache",
+        ImmApp::InstallFontAtlasCache,
+        py::arg("cache_folder"),
+        " InstallFontAtlasCache: replaces the font builder of ImGui::GetIO().Fonts by a caching builder\n which stores its entries in cacheFolder.\n (ImmApp::Run calls this automatically if AddOnsParams.withFontAtlasCache is True)");
+
+    m.def("font_atlas_cache_folder",
+        ImmApp::FontAtlasCacheFolder,
+        py::arg("runner_params"),
+        " FontAtlasCacheFolder returns the folder where the font atlas cache is stored\n (next to the ini settings file)");
+
+    m.def("delete_font_atlas_cache",
+        ImmApp::DeleteFontAtlasCache,
+        py::arg("runner_params"),
+        "DeleteFontAtlasCache deletes the font atlas cache folder");
+
+    m.def("get_font_atlas_cache_stats",
+        ImmApp::GetFontAtlasCacheStats);
+    ////////////////////    </generated_from:font_atlas_cache.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:font_atlas_parallel_build.h>    ////////////////////
+    m.def("install_parallel_font_builder",
+        ImmApp::InstallParallelFontBuilder,
+        py::arg("nb_threads") = 0,
+        " InstallParallelFontBuilder: replaces the font builder of ImGui::GetIO().Fonts by a builder\n which rasterizes the fonts on nbThreads threads (0 = number of hardware threads).\n (ImmApp::Run calls this automatically if AddOnsParams.withParallelFontBuild is True)");
+    ////////////////////    </generated_from:font_atlas_parallel_build.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:dynamic_glyphs.h>    ////////////////////
+    auto pyClassDynamicGlyphsStats =
+        py::class_<ImmApp::DynamicGlyphsStats>
+            (m, "DynamicGlyphsStats", "")
+        .def(py::init<>([](
+        int NbDynamicGlyphs = 0, int NbPendingGlyphs = 0, int NbRebuilds = 0, int NbEvictedGlyphs = 0)
+        {
+            auto r = std::make_unique<ImmApp::DynamicGlyphsStats>();
+            r->NbDynamicGlyphs = NbDynamicGlyphs;
+            r->NbPendingGlyphs = NbPendingGlyphs;
+            r->NbRebuilds = NbRebuilds;
+            r->NbEvictedGlyphs = NbEvictedGlyphs;
+            return r;
+        })
+        , py::arg("nb_dynamic_glyphs") = 0, py::arg("nb_pending_glyphs") = 0, py::arg("nb_rebuilds") = 0, py::arg("nb_evicted_glyphs") = 0
+        )
+        .def_readwrite("nb_dynamic_glyphs", &ImmApp::DynamicGlyphsStats::NbDynamicGlyphs, "Number of on demand glyphs currently loaded (all fonts)")
+        .def_readwrite("nb_pending_glyphs", &ImmApp::DynamicGlyphsStats::NbPendingGlyphs, "Number of glyphs waiting for the next rebuild")
+        .def_readwrite("nb_rebuilds", &ImmApp::DynamicGlyphsStats::NbRebuilds, "Number of atlas rebuilds triggered by RequestGlyphs")
+        .def_readwrite("nb_evicted_glyphs", &ImmApp::DynamicGlyphsStats::NbEvictedGlyphs, "Number of glyphs evicted since startup")
+        ;
+
+
+    m.def("load_font_with_dynamic_glyphs",
+        ImmApp::LoadFontWithDynamicGlyphs,
+        py::arg("font_filename"), py::arg("font_size"), py::arg("params") = HelloImGui::FontLoadingParams{}, py::arg("max_dynamic_glyphs") = 4096,
+        " LoadFontWithDynamicGlyphs: loads a font whose glyphs will be rasterized on demand\n (call it inside callbacks.LoadAdditionalFonts).\n   - params.glyphRanges are the base glyph ranges, which are always loaded\n     (if empty, ImGui default ranges are used: Basic Latin + Latin Supplement)\n   - params.useFullGlyphRange and params.mergeFontAwesome are ignored",
+        pybind11::return_value_policy::reference);
+
+    m.def("request_glyphs",
+        ImmApp::RequestGlyphs,
+        py::arg("text"),
+        " RequestGlyphs: call this with the (utf8) text you are about to display.\n The glyphs which are missing from the dynamic fonts will be available at the next frame\n (in the meantime, they are displayed with the fallback glyph).\n This is cheap when no glyph is missing: it can be called every frame.");
+
+    m.def("get_dynamic_glyphs_stats",
+        ImmApp::GetDynamicGlyphsStats);
+    ////////////////////    </generated_from:dynamic_glyphs.h>    ////////////////////
+
+
+    ////////////////////    <generated_from:font_atlas_async_rebuild.h>    ////////////////////
+    m.def("install_async_font_rebuild",
+        ImmApp::InstallAsyncFontRebuild, " InstallAsyncFontRebuild: replaces the font builder of ImGui::GetIO().Fonts by a builder\n which rebuilds the atlas asynchronously (the previous builder is used for synchronous builds)\n (ImmApp::Run calls this automatically if AddOnsParams.withAsyncFontRebuild is True)");
+
+    m.def("is_font_rebuild_pending",
+        ImmApp::IsFontRebuildPending, "IsFontRebuildPending returns True while the fonts are displayed with a scaled previous atlas");
+    ////////////////////    </generated_from:font_atlas_async_rebuild.h>    ////////////////////
+
+
     ////////////////////    <generated_from:code_utils.h>    ////////////////////
 
     { // <namespace CodeUtils>
@@ -240,7 +529,7 @@ void py_init_module_immapp_cpp(py::module& m)
             py::class_<Snippets::SnippetData>
                 (pyNsSnippets, "SnippetData", "")
             .def(py::init<>([](
-            std::string Code = "", Snippets::SnippetLanguage Language = Snippets::DefaultSnippetLanguage(), Snippets::SnippetTheme Palette = Snippets::SnippetTheme::Light, bool ShowCopyButton = true, bool ShowCursorPosition = true, std::string DisplayedFilename = {}, int HeightInLines = 0, int MaxHeightInLines = 40, bool ReadOnly = false, bool Border = false, bool DeIndentCode = true)
+            std::string Code = "", Snippets::SnippetLanguage Language = Snippets::DefaultSnippetLanguage(), Snippets::SnippetTheme Palette = Snippets::SnippetTheme::Light, bool ShowCopyButton = true, bool ShowCursorPosition = true, std::string DisplayedFilename = {}, int HeightInLines = 0, int MaxHeightInLines = 40, bool ReadOnly = false, bool Border = false, bool DeIndentCode = true, bool Virtualized = false)
             {
                 auto r = std::make_unique<Snippets::SnippetData>();
                 r->Code = Code;
@@ -254,9 +543,10 @@ void py_init_module_immapp_cpp(py::module& m)
                 r->ReadOnly = ReadOnly;
                 r->Border = Border;
                 r->DeIndentCode = DeIndentCode;
+                r->Virtualized = Virtualized;
                 return r;
             })
-            , py::arg("code") = "", py::arg("language") = Snippets::DefaultSnippetLanguage(), py::arg("palette") = Snippets::SnippetTheme::Light, py::arg("show_copy_button") = true, py::arg("show_cursor_position") = true, py::arg("displayed_filename") = std::string{}, py::arg("height_in_lines") = 0, py::arg("max_height_in_lines") = 40, py::arg("read_only") = false, py::arg("border") = false, py::arg("de_indent_code") = true
+            , py::arg("code") = "", py::arg("language") = Snippets::DefaultSnippetLanguage(), py::arg("palette") = Snippets::SnippetTheme::Light, py::arg("show_copy_button") = true, py::arg("show_cursor_position") = true, py::arg("displayed_filename") = std::string{}, py::arg("height_in_lines") = 0, py::arg("max_height_in_lines") = 40, py::arg("read_only") = false, py::arg("border") = false, py::arg("de_indent_code") = true, py::arg("virtualized") = false
             )
             .def_readwrite("code", &Snippets::SnippetData::Code, "")
             .def_readwrite("language", &Snippets::SnippetData::Language, "")
@@ -269,17 +559,55 @@ void py_init_module_immapp_cpp(py::module& m)
             .def_readwrite("read_only", &Snippets::SnippetData::ReadOnly, "Snippets are read-only by default")
             .def_readwrite("border", &Snippets::SnippetData::Border, "Draw a border around the editor")
             .def_readwrite("de_indent_code", &Snippets::SnippetData::DeIndentCode, "Keep the code indentation, but remove main indentation,")
+            .def_readwrite("virtualized", &Snippets::SnippetData::Virtualized, "For very large snippets (logs, generated code...): only the visible lines")
             ;
 
 
         pyNsSnippets.def("show_code_snippet",
-            Snippets::ShowCodeSnippet, py::arg("snippet_data"), py::arg("width") = 0.f, py::arg("override_height_in_lines") = 0);
+            Snippets::ShowCodeSnippet, py::arg("snippet_data"), py::arg("width") = 0.f, py::arg("override_height_in_lines") = 0,
+            " ShowCodeSnippet: the editor of a snippet is cached, keyed by a hash of its code (see below).\n For large codes, this hash only reads a few samples of the code: if the code is modified in place\n without changing its size, and outside of these samples, the cached editor (or line index, for virtualized snippets) still shows the previous code.\n Call ClearSnippetCache() after such a modification.");
 
         pyNsSnippets.def("show_side_by_side_snippets",
             py::overload_cast<const Snippets::SnippetData &, const Snippets::SnippetData &, bool, bool>(Snippets::ShowSideBySideSnippets), py::arg("snippet1"), py::arg("snippet2"), py::arg("hide_if_empty") = true, py::arg("equal_visible_lines") = true);
 
         pyNsSnippets.def("show_side_by_side_snippets",
             py::overload_cast<const std::vector<Snippets::SnippetData> &, bool, bool>(Snippets::ShowSideBySideSnippets), py::arg("snippets"), py::arg("hide_if_empty") = true, py::arg("equal_visible_lines") = true);
+
+
+        auto pyNsSnippets_ClassSnippetCacheStats =
+            py::class_<Snippets::SnippetCacheStats>
+                (pyNsSnippets, "SnippetCacheStats", "")
+            .def(py::init<>([](
+            int NbEntries = 0, int NbHits = 0, int NbMisses = 0, int NbEvictions = 0, size_t CodeBytes = 0)
+            {
+                auto r = std::make_unique<Snippets::SnippetCacheStats>();
+                r->NbEntries = NbEntries;
+                r->NbHits = NbHits;
+                r->NbMisses = NbMisses;
+                r->NbEvictions = NbEvictions;
+                r->CodeBytes = CodeBytes;
+                return r;
+            })
+            , py::arg("nb_entries") = 0, py::arg("nb_hits") = 0, py::arg("nb_misses") = 0, py::arg("nb_evictions") = 0, py::arg("code_bytes") = 0
+            )
+            .def_readwrite("nb_entries", &Snippets::SnippetCacheStats::NbEntries, "")
+            .def_readwrite("nb_hits", &Snippets::SnippetCacheStats::NbHits, "")
+            .def_readwrite("nb_misses", &Snippets::SnippetCacheStats::NbMisses, "")
+            .def_readwrite("nb_evictions", &Snippets::SnippetCacheStats::NbEvictions, "")
+            .def_readwrite("code_bytes", &Snippets::SnippetCacheStats::CodeBytes, "Total size of the cached code (and of the line indexes and syntax colors of virtualized snippets)")
+            ;
+
+
+        pyNsSnippets.def("get_snippet_cache_stats",
+            Snippets::GetSnippetCacheStats);
+
+        pyNsSnippets.def("set_snippet_cache_capacity",
+            Snippets::SetSnippetCacheCapacity,
+            py::arg("capacity"),
+            "Default capacity: 256 snippets");
+
+        pyNsSnippets.def("clear_snippet_cache",
+            Snippets::ClearSnippetCache);
     } // </namespace Snippets>
     ////////////////////    </generated_from:snippets.h>    ////////////////////
 
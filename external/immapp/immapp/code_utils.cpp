@@ -1,95 +1,128 @@
-#include <fplus/fplus.hpp>
+#include "immapp/code_utils.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace CodeUtils
 {
-    using Lines = std::vector<std::string>;
-    using String = std::string;
-
-
-    bool IsSpaceOrEmpty(const String& s)
-    {
-        return fplus::trim_whitespace(s).size() == 0;
-    }
-
-
-    Lines StripEmptyLinesInList(const Lines& code_lines)
+    // The functions below work on string views, without splitting the code into a vector of lines.
+    // Line breaks are "\n", "\r\n" or "\r" (as with fplus::split_lines).
+    namespace
     {
-        Lines r;
-        r = fplus::drop_while(IsSpaceOrEmpty, code_lines);
-        r = fplus::reverse(r);
-        r = fplus::drop_while(IsSpaceOrEmpty, r);
-        r = fplus::reverse(r);
-        return r;
-    }
+        bool IsWhitespace(char c)
+        {
+            return c == ' ' || (c >= 9 && c <= 13);
+        }
 
+        bool IsSpaceOrEmpty(std::string_view line)
+        {
+            return std::all_of(line.begin(), line.end(), IsWhitespace);
+        }
 
-    String StripEmptyLines(const String& s)
-    {
-        auto lines = fplus::split_lines(true, s);
-        auto lines_stripped = StripEmptyLinesInList(lines);
-        String r = fplus::join(std::string("\n"), lines_stripped);
-        return r;
-    }
+        // Iterates over the lines of a code, without copying them
+        class LineIterator
+        {
+        public:
+            explicit LineIterator(std::string_view code)
+                : mCode(code), mHasCarriageReturns(!code.empty() && memchr(code.data(), '\r', code.size()) != nullptr) {}
+
+            // Returns false after the last line (an empty code has one empty line)
+            bool Next(std::string_view* line)
+            {
+                if (mPos > mCode.size())
+                    return false;
+                const char* begin = mCode.data() + mPos;
+                const char* end = mCode.data() + mCode.size();
+                // memchr is vectorized by the C library: this is the fast path
+                const char* lineEnd = mHasCarriageReturns
+                    ? std::find_if(begin, end, [](char c) { return c == '\n' || c == '\r'; })
+                    : (const char*)memchr(begin, '\n', (size_t)(end - begin));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+                *line = std::string_view(begin, (size_t)(lineEnd - begin));
+                mPos = (size_t)(lineEnd - mCode.data()) + 1;
+                if (lineEnd < end && *lineEnd == '\r' && lineEnd + 1 < end && lineEnd[1] == '\n')
+                    ++mPos;
+                return true;
+            }
+
+        private:
+            std::string_view mCode;
+            bool mHasCarriageReturns;
+            size_t mPos = 0;
+        };
+
+        int CountSpacesAtStartOfLine(std::string_view line)
+        {
+            size_t n = line.find_first_not_of(' ');
+            return (int)(n == std::string_view::npos ? line.size() : n);
+        }
 
+        std::string_view RemoveTrailingSpace(std::string_view line)
+        {
+            size_t n = line.find_last_not_of(' ');
+            return n == std::string_view::npos ? std::string_view() : line.substr(0, n + 1);
+        }
 
-    int CountSpacesAtStartOfLine(const String& line)
-    {
-        int nbSpacesthisLine = 0;
-        for (auto c : line)
-            if (c == ' ')
-                ++nbSpacesthisLine;
-            else
-                return nbSpacesthisLine;
-        return nbSpacesthisLine;
-    }
+        int ComputeCodeIndentSize(std::string_view code)
+        {
+            LineIterator lines(code);
+            std::string_view line;
+            while (lines.Next(&line))
+            {
+                if (IsSpaceOrEmpty(line))
+                    continue;
+                return CountSpacesAtStartOfLine(line);
+            }
+            return 0;
+        }
+    } // anonymous namespace
 
 
-    String RemoveTrailingSpace(const String& line)
+    void UnindentInto(std::string_view code, bool is_markdown, std::string* out)
     {
-        return fplus::trim_right(' ', line);
-    }
+        out->clear();
+        int indentSize = ComputeCodeIndentSize(code);
 
+        // Blank lines at the start are skipped. Blank lines at the end are removed once the end is reached:
+        // sizeBeforeBlankLines remembers where the current run of blank lines started in the output.
+        bool hasWrittenLine = false;
+        size_t sizeBeforeBlankLines = std::string::npos;
 
-    int ComputeCodeIndentSize(const String& code)
-    {
-        auto lines = fplus::split_lines(true, code);
-        for (const auto& line: lines)
+        LineIterator lines(code);
+        std::string_view line;
+        while (lines.Next(&line))
         {
-            if (IsSpaceOrEmpty(line))
+            bool isBlank = IsSpaceOrEmpty(line);
+            if (isBlank && !hasWrittenLine)
                 continue;
-            return CountSpacesAtStartOfLine(line);
+            if (isBlank && sizeBeforeBlankLines == std::string::npos)
+                sizeBeforeBlankLines = out->size();
+            if (!isBlank)
+                sizeBeforeBlankLines = std::string::npos;
+
+            if (CountSpacesAtStartOfLine(line) >= indentSize)
+                line.remove_prefix((size_t)indentSize);
+            if (!is_markdown)
+                line = RemoveTrailingSpace(line);
+
+            if (hasWrittenLine)
+                out->push_back('\n');
+            out->append(line.data(), line.size());
+            if (is_markdown)
+                out->push_back(' ');
+            hasWrittenLine = true;
         }
-        return 0;
+
+        if (sizeBeforeBlankLines != std::string::npos)
+            out->resize(sizeBeforeBlankLines);
     }
 
 
     std::string Unindent(const std::string& code, bool is_markdown)
     {
-        int indentSize = ComputeCodeIndentSize(code);
-
-        String whatToReplace;
-        for (auto i = 0; i < indentSize; ++i)
-            whatToReplace += " ";
-
-        auto lines = fplus::split_lines(true, code);
-
-        Lines processedLines;
-        for (const auto& line: lines)
-        {
-            String processedLine;
-            if (fplus::is_prefix_of(whatToReplace, line))
-                processedLine = fplus::drop(indentSize, line);
-            else
-                processedLine = line;
-
-            if (is_markdown)
-                processedLines.push_back(processedLine + " ");
-             else
-                processedLines.push_back(RemoveTrailingSpace(processedLine));
-        }
-
-        String r = fplus::join(std::string("\n"), processedLines);
-        r = StripEmptyLines(r);
+        std::string r;
+        UnindentInto(code, is_markdown, &r);
         return r;
     }
 
@@ -1,4 +1,6 @@
-#include <fplus/fplus.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace CodeUtils
 {
@@ -8,4 +10,8 @@ namespace CodeUtils
     std::string Unindent(const std::string& code, bool is_markdown);
     std::string UnindentCode(const std::string& code);
     std::string UnindentMarkdown(const std::string& code);
+
+    // UnindentInto: same as Unindent, but writes into a caller provided buffer
+    // (whose capacity is reused: no allocation once it is large enough)
+    void UnindentInto(std::string_view code, bool is_markdown, std::string* out);
 } // namespace CodeUtils
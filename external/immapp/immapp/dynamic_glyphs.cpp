@@ -0,0 +1,271 @@
+#include "immapp/dynamic_glyphs.h"
+#include "hello_imgui/internal/functional_utils.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        struct DynamicFont
+        {
+            std::string FontFilename;
+            float FontSize = 0.f;
+            ImFont* Font = nullptr;
+            int ConfigIndex = -1;
+            int MaxDynamicGlyphs = 0;       // The budget given to LoadFontWithDynamicGlyphs (never changed)
+            int LastBudgetCheckFrame = -1;
+            std::vector<HelloImGui::ImWcharPair> BaseRanges;
+
+            // On demand glyphs, with the frame of their last request
+            std::unordered_map<ImWchar, int> DynamicGlyphs;
+            // Glyphs waiting for the next rebuild
+            std::set<ImWchar> PendingGlyphs;
+            // Zero terminated ranges, used by the font config: they must stay alive as long as the atlas uses them
+            std::vector<ImWchar> GlyphRanges;
+        };
+
+        std::vector<DynamicFont> gDynamicFonts;
+        bool gRebuildRequested = false;
+        int gNbRebuilds = 0;
+        int gNbEvictedGlyphs = 0;
+
+        // A font over its budget is checked at most once per kNbFramesBetweenBudgetChecks frames
+        constexpr int kNbFramesBetweenBudgetChecks = 60;
+
+        // Fonts are invalidated when the atlas is cleared (e.g. when the fonts are reloaded after a DPI change)
+        bool IsFontAlive(const DynamicFont& dynamicFont)
+        {
+            ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+            return dynamicFont.ConfigIndex < atlas->ConfigData.Size
+                && atlas->ConfigData[dynamicFont.ConfigIndex].DstFont == dynamicFont.Font;
+        }
+
+        // Merges the base ranges and the on demand glyphs into sorted, zero terminated glyph ranges
+        std::vector<ImWchar> MakeGlyphRanges(const DynamicFont& dynamicFont)
+        {
+            std::vector<std::pair<unsigned int, unsigned int>> intervals;
+            for (const auto& range: dynamicFont.BaseRanges)
+                intervals.push_back({ range[0], range[1] });
+            for (const auto& kv: dynamicFont.DynamicGlyphs)
+                intervals.push_back({ kv.first, kv.first });
+            std::sort(intervals.begin(), intervals.end());
+
+            std::vector<ImWchar> ranges;
+            for (const auto& interval: intervals)
+            {
+                if (!ranges.empty() && interval.first <= (unsigned int)ranges.back() + 1)
+                    ranges.back() = (ImWchar)std::max((unsigned int)ranges.back(), interval.second);
+                else
+                {
+                    ranges.push_back((ImWchar)interval.first);
+                    ranges.push_back((ImWchar)interval.second);
+                }
+            }
+            ranges.push_back(0);
+            return ranges;
+        }
+
+        void UpdateFontConfigGlyphRanges(DynamicFont& dynamicFont)
+        {
+            std::vector<ImWchar> ranges = MakeGlyphRanges(dynamicFont);
+            ImGui::GetIO().Fonts->ConfigData[dynamicFont.ConfigIndex].GlyphRanges = ranges.data();
+            dynamicFont.GlyphRanges = std::move(ranges);
+        }
+
+        // The glyphs requested during the current or the previous frame may be displayed right now
+        bool IsGlyphInUse(int lastRequestFrame, int frameCount)
+        {
+            return lastRequestFrame >= frameCount - 1;
+        }
+
+        // Evicts the least recently requested glyphs, if there are too many.
+        // The glyphs in use are never evicted: the font may then stay over its budget until a later rebuild.
+        void EvictGlyphs(DynamicFont& dynamicFont, int frameCount)
+        {
+            int nbExtraGlyphs = (int)dynamicFont.DynamicGlyphs.size() - dynamicFont.MaxDynamicGlyphs;
+            if (nbExtraGlyphs <= 0)
+                return;
+            std::vector<std::pair<int, ImWchar>> glyphsByLastUse;
+            for (const auto& kv: dynamicFont.DynamicGlyphs)
+                if (!IsGlyphInUse(kv.second, frameCount))
+                    glyphsByLastUse.push_back({ kv.second, kv.first });
+            std::sort(glyphsByLastUse.begin(), glyphsByLastUse.end());
+            int nbEvictedGlyphs = std::min(nbExtraGlyphs, (int)glyphsByLastUse.size());
+            for (int i = 0; i < nbEvictedGlyphs; ++i)
+                dynamicFont.DynamicGlyphs.erase(glyphsByLastUse[(size_t)i].second);
+            gNbEvictedGlyphs += nbEvictedGlyphs;
+        }
+
+        bool IsOverBudget(const DynamicFont& dynamicFont)
+        {
+            return (int)dynamicFont.DynamicGlyphs.size() > dynamicFont.MaxDynamicGlyphs;
+        }
+
+        // Called by HelloImGui at the frame boundary (as a LoadAdditionalFonts callback):
+        // the atlas will be rebuilt after this
+        void ApplyPendingGlyphs()
+        {
+            int frameCount = ImGui::GetFrameCount();
+            for (auto& dynamicFont: gDynamicFonts)
+            {
+                if ((dynamicFont.PendingGlyphs.empty() && !IsOverBudget(dynamicFont)) || !IsFontAlive(dynamicFont))
+                    continue;
+                for (ImWchar c: dynamicFont.PendingGlyphs)
+                    dynamicFont.DynamicGlyphs[c] = frameCount;
+                dynamicFont.PendingGlyphs.clear();
+                EvictGlyphs(dynamicFont, frameCount);
+                UpdateFontConfigGlyphRanges(dynamicFont);
+            }
+            ImGui::GetIO().Fonts->ClearTexData();
+            ++gNbRebuilds;
+            gRebuildRequested = false;
+        }
+
+        // Asks HelloImGui to rebuild the fonts at the next frame boundary (once)
+        void RequestRebuild()
+        {
+            if (gRebuildRequested)
+                return;
+            auto runnerParams = HelloImGui::GetRunnerParams();
+            if (runnerParams == nullptr)
+                return;
+            auto& loadAdditionalFonts = runnerParams->callbacks.LoadAdditionalFonts;
+            if (loadAdditionalFonts)
+                loadAdditionalFonts = HelloImGui::SequenceFunctions(loadAdditionalFonts, ApplyPendingGlyphs);
+            else
+                loadAdditionalFonts = ApplyPendingGlyphs;
+            gRebuildRequested = true;
+        }
+
+        // A font which went over its budget (because its glyphs were in use) is brought back to it
+        // by a rebuild, once some of its glyphs are no longer in use
+        void CheckBudget(DynamicFont& dynamicFont, int frameCount)
+        {
+            if (!IsOverBudget(dynamicFont) || frameCount < dynamicFont.LastBudgetCheckFrame + kNbFramesBetweenBudgetChecks)
+                return;
+            dynamicFont.LastBudgetCheckFrame = frameCount;
+            bool canEvict = std::any_of(dynamicFont.DynamicGlyphs.begin(), dynamicFont.DynamicGlyphs.end(),
+                [frameCount](const auto& kv) { return !IsGlyphInUse(kv.second, frameCount); });
+            if (canEvict && IsFontAlive(dynamicFont))
+                RequestRebuild();
+        }
+    } // anonymous namespace
+
+
+    namespace FontAtlasInternal
+    {
+        // True if the atlas contains glyphs loaded on demand (used by the font atlas cache,
+        // which does not store such atlases: they change with each batch of requested glyphs)
+        bool HasDynamicGlyphs()
+        {
+            for (const auto& dynamicFont: gDynamicFonts)
+                if (!dynamicFont.DynamicGlyphs.empty() && IsFontAlive(dynamicFont))
+                    return true;
+            return false;
+        }
+    }
+
+
+    ImFont* LoadFontWithDynamicGlyphs(
+        const std::string& fontFilename, float fontSize,
+        const HelloImGui::FontLoadingParams& params,
+        int maxDynamicGlyphs)
+    {
+        HelloImGui::FontLoadingParams baseParams = params;
+        baseParams.useFullGlyphRange = false;
+        baseParams.mergeFontAwesome = false;
+        if (baseParams.glyphRanges.empty())
+            baseParams.glyphRanges = { { 0x0020, 0x00FF } };
+
+        if (HelloImGui::LoadFont(fontFilename, fontSize, baseParams) == nullptr)
+            return nullptr;
+
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        DynamicFont dynamicFont;
+        dynamicFont.FontFilename = fontFilename;
+        dynamicFont.FontSize = fontSize;
+        dynamicFont.ConfigIndex = atlas->ConfigData.Size - 1;
+        dynamicFont.Font = atlas->ConfigData.back().DstFont;
+        dynamicFont.MaxDynamicGlyphs = maxDynamicGlyphs;
+        dynamicFont.BaseRanges = baseParams.glyphRanges;
+
+        // When the fonts are reloaded (e.g. after a DPI change), keep the glyphs that were loaded on demand
+        for (auto& previousFont: gDynamicFonts)
+        {
+            if (previousFont.FontFilename == fontFilename && previousFont.FontSize == fontSize && !IsFontAlive(previousFont))
+            {
+                dynamicFont.DynamicGlyphs = std::move(previousFont.DynamicGlyphs);
+                for (ImWchar c: previousFont.PendingGlyphs)
+                    dynamicFont.DynamicGlyphs[c] = ImGui::GetFrameCount();
+                EvictGlyphs(dynamicFont, ImGui::GetFrameCount());
+                break;
+            }
+        }
+        gDynamicFonts.erase(
+            std::remove_if(gDynamicFonts.begin(), gDynamicFonts.end(), [](const DynamicFont& f) { return !IsFontAlive(f); }),
+            gDynamicFonts.end());
+
+        gDynamicFonts.push_back(std::move(dynamicFont));
+        UpdateFontConfigGlyphRanges(gDynamicFonts.back());
+        return gDynamicFonts.back().Font;
+    }
+
+
+    void RequestGlyphs(const std::string& text)
+    {
+        if (gDynamicFonts.empty())
+            return;
+        int frameCount = ImGui::GetFrameCount();
+        for (auto& dynamicFont: gDynamicFonts)
+            CheckBudget(dynamicFont, frameCount);
+
+        const char* s = text.c_str();
+        const char* textEnd = s + text.size();
+        while (s < textEnd)
+        {
+            unsigned int c;
+            s += ImTextCharFromUtf8(&c, s, textEnd);
+            if (c == 0 || c > IM_UNICODE_CODEPOINT_MAX || c == IM_UNICODE_CODEPOINT_INVALID)
+                continue;
+            for (auto& dynamicFont: gDynamicFonts)
+            {
+                auto it = dynamicFont.DynamicGlyphs.find((ImWchar)c);
+                if (it != dynamicFont.DynamicGlyphs.end())
+                {
+                    // Already requested (whether the font file provides it or not)
+                    it->second = frameCount;
+                    continue;
+                }
+                if (dynamicFont.PendingGlyphs.count((ImWchar)c) > 0 || !IsFontAlive(dynamicFont))
+                    continue;
+                if (dynamicFont.Font->FindGlyphNoFallback((ImWchar)c) != nullptr)
+                    continue;
+                dynamicFont.PendingGlyphs.insert((ImWchar)c);
+                RequestRebuild();
+            }
+        }
+    }
+
+
+    DynamicGlyphsStats GetDynamicGlyphsStats()
+    {
+        DynamicGlyphsStats r;
+        for (const auto& dynamicFont: gDynamicFonts)
+        {
+            r.NbDynamicGlyphs += (int)dynamicFont.DynamicGlyphs.size();
+            r.NbPendingGlyphs += (int)dynamicFont.PendingGlyphs.size();
+        }
+        r.NbRebuilds = gNbRebuilds;
+        r.NbEvictedGlyphs = gNbEvictedGlyphs;
+        return r;
+    }
+
+} // namespace ImmApp
@@ -0,0 +1,55 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+#include <string>
+
+
+namespace ImmApp
+{
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Dynamic glyphs: on demand rasterization for fonts with large glyph ranges (CJK, symbols, ...)
+    //
+    // Loading such fonts with their full glyph range leads to font atlases of tens of MB,
+    // although an application session usually uses a few hundred of their glyphs.
+    //
+    // A font loaded with LoadFontWithDynamicGlyphs() is first rasterized with its base glyph ranges only.
+    // RequestGlyphs(text) queues the glyphs of the text which are missing from the font: they are
+    // rasterized in a batch at the next frame boundary (the atlas is rebuilt once, with all the queued glyphs).
+    // When a font holds more than maxDynamicGlyphs on demand glyphs, the least recently requested
+    // ones are evicted at the next rebuild. The glyphs requested during the current or the previous
+    // frame are never evicted: the font may then exceed its budget for a while, and it is brought back
+    // to it by a later rebuild (checked every 60 frames), when these glyphs are no longer in use.
+    // Atlases with on demand glyphs are not written to the font atlas cache (they change with each batch).
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+
+    struct DynamicGlyphsStats
+    {
+        // Number of on demand glyphs currently loaded (all fonts)
+        int NbDynamicGlyphs = 0;
+        // Number of glyphs waiting for the next rebuild
+        int NbPendingGlyphs = 0;
+        // Number of atlas rebuilds triggered by RequestGlyphs
+        int NbRebuilds = 0;
+        // Number of glyphs evicted since startup
+        int NbEvictedGlyphs = 0;
+    };
+
+    // LoadFontWithDynamicGlyphs: loads a font whose glyphs will be rasterized on demand
+    // (call it inside callbacks.LoadAdditionalFonts).
+    //   - params.glyphRanges are the base glyph ranges, which are always loaded
+    //     (if empty, ImGui default ranges are used: Basic Latin + Latin Supplement)
+    //   - params.useFullGlyphRange and params.mergeFontAwesome are ignored
+    ImFont* LoadFontWithDynamicGlyphs(
+        const std::string& fontFilename, float fontSize,
+        const HelloImGui::FontLoadingParams& params = {},
+        int maxDynamicGlyphs = 4096);
+
+    // RequestGlyphs: call this with the (utf8) text you are about to display.
+    // The glyphs which are missing from the dynamic fonts will be available at the next frame
+    // (in the meantime, they are displayed with the fallback glyph).
+    // This is cheap when no glyph is missing: it can be called every frame.
+    void RequestGlyphs(const std::string& text);
+
+    DynamicGlyphsStats GetDynamicGlyphsStats();
+} // namespace ImmApp
@@ -0,0 +1,341 @@
+#include "immapp/font_atlas_async_rebuild.h"
+#include "immapp/internal/font_atlas_rasterizer.h"
+#include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/functional_utils.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define IMMAPP_FONT_BUILD_NO_THREADS
+#endif
+
+
+namespace ImmApp
+{
+    namespace FontAtlasInternal
+    {
+        // Private API, implemented in font_atlas_cache.cpp
+        const ImFontBuilderIO* DefaultFontBuilderIO();
+        void RegisterDelegatingFontBuilder(const ImFontBuilderIO* builderIO, const char* name, const ImFontBuilderIO* delegateBuilderIO);
+        uint64_t AtlasKey(const ImFontAtlas* atlas);
+    }
+
+    namespace
+    {
+        const ImFontBuilderIO* gDelegateBuilderIO = nullptr;
+
+        // A copy of the output of an atlas build
+        struct AtlasSnapshot
+        {
+            struct FontData
+            {
+                float FontSize = 0.f, Ascent = 0.f, Descent = 0.f;
+                int MetricsTotalSurface = 0;
+                ImVector<ImFontGlyph> Glyphs;
+            };
+
+            bool IsValid = false;
+            int TexWidth = 0, TexHeight = 0;
+            bool TexPixelsUseColors = false;
+            std::vector<unsigned char> PixelsAlpha8;
+            std::vector<unsigned int> PixelsRGBA32;
+            std::vector<ImFontAtlasCustomRect> CustomRects;
+            std::vector<FontData> Fonts;
+        };
+
+        // A rebuild, rasterized by a worker thread (see font_atlas_rasterizer.h: the worker does not call ImGui)
+        // and assembled into the atlas by the main thread
+        struct StagingBuild
+        {
+            uint64_t Key = 0;
+            // Copies of the font files (one per file, even if it is used by several configs),
+            // since the atlas may free the original ones during the build
+            std::vector<std::vector<unsigned char>> FontFiles;
+            std::vector<FontAtlasInternal::RasterizerFontGroup> Groups;
+            std::thread Thread;
+            std::atomic<bool> IsDone { false };
+            bool Success = false;
+
+            ~StagingBuild()
+            {
+                if (Thread.joinable())
+                    Thread.join();
+            }
+        };
+
+        // The last built atlas: its glyphs are displayed (scaled) while a rebuild is in progress
+        AtlasSnapshot gSnapshot;
+        std::unique_ptr<StagingBuild> gStagingBuild;
+        bool gIsRebuildPending = false;
+        bool gSwapRequested = false;
+
+
+        AtlasSnapshot TakeSnapshot(const ImFontAtlas* atlas)
+        {
+            AtlasSnapshot r;
+            size_t nbPixels = (size_t)atlas->TexWidth * (size_t)atlas->TexHeight;
+            if (atlas->TexPixelsAlpha8 != nullptr)
+                r.PixelsAlpha8.assign(atlas->TexPixelsAlpha8, atlas->TexPixelsAlpha8 + nbPixels);
+            else if (atlas->TexPixelsRGBA32 != nullptr)
+                r.PixelsRGBA32.assign(atlas->TexPixelsRGBA32, atlas->TexPixelsRGBA32 + nbPixels);
+            else
+                return r;
+            r.TexWidth = atlas->TexWidth;
+            r.TexHeight = atlas->TexHeight;
+            r.TexPixelsUseColors = atlas->TexPixelsUseColors;
+            r.CustomRects.assign(atlas->CustomRects.begin(), atlas->CustomRects.end());
+            for (const ImFont* font: atlas->Fonts)
+            {
+                AtlasSnapshot::FontData fontData;
+                fontData.FontSize = font->FontSize;
+                fontData.Ascent = font->Ascent;
+                fontData.Descent = font->Descent;
+                fontData.MetricsTotalSurface = font->MetricsTotalSurface;
+                fontData.Glyphs = font->Glyphs;
+                r.Fonts.push_back(fontData);
+            }
+            r.IsValid = true;
+            return r;
+        }
+
+        int NbUserCustomRects(const ImFontAtlas* atlas)
+        {
+            return atlas->CustomRects.Size - (atlas->PackIdMouseCursors >= 0 ? 1 : 0) - (atlas->PackIdLines >= 0 ? 1 : 0);
+        }
+
+        int FontIndex(const ImFontAtlas* atlas, const ImFont* font)
+        {
+            for (int i = 0; i < atlas->Fonts.Size; ++i)
+                if (atlas->Fonts[i] == font)
+                    return i;
+            return -1;
+        }
+
+        // Fills the atlas with the snapshot output. When the font sizes differ (e.g. after a DPI change),
+        // the glyphs are scaled to the new sizes.
+        bool ApplySnapshot(ImFontAtlas* atlas, const AtlasSnapshot& snapshot)
+        {
+            if (!snapshot.IsValid || (int)snapshot.Fonts.size() != atlas->Fonts.Size)
+                return false;
+            // Registers the default custom rects (mouse cursors, lines), whose positions we will restore
+            ImFontAtlasBuildInit(atlas);
+            if ((int)snapshot.CustomRects.size() != atlas->CustomRects.Size)
+                return false;
+            for (int i = 0; i < atlas->CustomRects.Size; ++i)
+            {
+                const auto& rect = snapshot.CustomRects[(size_t)i];
+                if (rect.Width != atlas->CustomRects[i].Width || rect.Height != atlas->CustomRects[i].Height)
+                    return false;
+            }
+
+            atlas->TexID = (ImTextureID)0;
+            atlas->ClearTexData();
+            atlas->TexWidth = snapshot.TexWidth;
+            atlas->TexHeight = snapshot.TexHeight;
+            atlas->TexUvScale = ImVec2(1.0f / (float)snapshot.TexWidth, 1.0f / (float)snapshot.TexHeight);
+            atlas->TexPixelsUseColors = snapshot.TexPixelsUseColors;
+            if (!snapshot.PixelsAlpha8.empty())
+            {
+                atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(snapshot.PixelsAlpha8.size());
+                memcpy(atlas->TexPixelsAlpha8, snapshot.PixelsAlpha8.data(), snapshot.PixelsAlpha8.size());
+            }
+            else
+            {
+                atlas->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(snapshot.PixelsRGBA32.size() * 4);
+                memcpy(atlas->TexPixelsRGBA32, snapshot.PixelsRGBA32.data(), snapshot.PixelsRGBA32.size() * 4);
+            }
+            for (int i = 0; i < atlas->CustomRects.Size; ++i)
+            {
+                atlas->CustomRects[i].X = snapshot.CustomRects[(size_t)i].X;
+                atlas->CustomRects[i].Y = snapshot.CustomRects[(size_t)i].Y;
+            }
+
+            // Setup the fonts, as the builders do (merged configs only increment ConfigDataCount)
+            for (ImFontConfig& cfg: atlas->ConfigData)
+            {
+                int fontIdx = FontIndex(atlas, cfg.DstFont);
+                IM_ASSERT(fontIdx >= 0);
+                const auto& fontData = snapshot.Fonts[(size_t)fontIdx];
+                float k = cfg.SizePixels / fontData.FontSize;
+                ImFontAtlasBuildSetupFont(atlas, cfg.DstFont, &cfg, fontData.Ascent * k, fontData.Descent * k);
+            }
+            for (int i = 0; i < atlas->Fonts.Size; ++i)
+            {
+                ImFont* font = atlas->Fonts[i];
+                const auto& fontData = snapshot.Fonts[(size_t)i];
+                float k = font->FontSize / fontData.FontSize;
+                font->Glyphs = fontData.Glyphs;
+                if (k != 1.f)
+                {
+                    for (ImFontGlyph& glyph: font->Glyphs)
+                    {
+                        glyph.X0 *= k; glyph.Y0 *= k;
+                        glyph.X1 *= k; glyph.Y1 *= k;
+                        glyph.AdvanceX *= k;
+                    }
+                }
+                font->MetricsTotalSurface = fontData.MetricsTotalSurface;
+                font->DirtyLookupTables = true;
+            }
+
+            // Renders the default texture data (white pixel, cursors, lines) & builds the lookup tables
+            ImFontAtlasBuildFinish(atlas);
+            return true;
+        }
+
+
+#ifndef IMMAPP_FONT_BUILD_NO_THREADS
+        // Copies the fonts inputs, and rasterizes them on a worker thread
+        // (only with stb_truetype: FreeType allocates through ImGui, and the rebuild then stays synchronous)
+        std::unique_ptr<StagingBuild> StartStagingBuild(const ImFontAtlas* atlas, uint64_t key)
+        {
+            if (!FontAtlasInternal::CanRasterizeOffThread(gDelegateBuilderIO))
+                return nullptr;
+            auto build = std::make_unique<StagingBuild>();
+            build->Key = key;
+            build->Groups = FontAtlasInternal::MakeRasterizerFontGroups(atlas);
+            std::unordered_map<const void*, size_t> fontFileIndices;
+            for (auto& group: build->Groups)
+            {
+                for (auto& input: group.Configs)
+                {
+                    auto it = fontFileIndices.find(input.FontData);
+                    if (it == fontFileIndices.end())
+                    {
+                        const unsigned char* fontData = (const unsigned char*)input.FontData;
+                        build->FontFiles.emplace_back(fontData, fontData + input.FontDataSize);
+                        it = fontFileIndices.insert({ input.FontData, build->FontFiles.size() - 1 }).first;
+                    }
+                    input.FontData = build->FontFiles[it->second].data(); // (stable when FontFiles grows)
+                }
+            }
+
+            StagingBuild* buildPtr = build.get();
+            build->Thread = std::thread([buildPtr]() {
+                bool success = true;
+                for (auto& group: buildPtr->Groups)
+                    success = FontAtlasInternal::RasterizeFontGroup(&group) && success;
+                buildPtr->Success = success;
+                buildPtr->IsDone.store(true, std::memory_order_release);
+            });
+            return build;
+        }
+#endif
+
+
+        bool AsyncFontBuilder_Build(ImFontAtlas* atlas)
+        {
+            IM_ASSERT(gDelegateBuilderIO != nullptr);
+#ifndef IMMAPP_FONT_BUILD_NO_THREADS
+            uint64_t key = FontAtlasInternal::AtlasKey(atlas);
+
+            // The staging atlas is ready: swap it in, if it matches the current fonts
+            if (gStagingBuild && gStagingBuild->IsDone.load(std::memory_order_acquire))
+            {
+                std::unique_ptr<StagingBuild> build = std::move(gStagingBuild);
+                build->Thread.join();
+                if (build->Success && build->Key == key && FontAtlasInternal::AssembleRasterizedAtlas(atlas, build->Groups))
+                {
+                    gSnapshot = TakeSnapshot(atlas);
+                    gIsRebuildPending = false;
+                    return true;
+                }
+            }
+
+            // A rebuild: display the previous atlas (scaled), while the new one is built by a worker thread
+            bool canReusePreviousAtlas = gSnapshot.IsValid
+                && (int)gSnapshot.Fonts.size() == atlas->Fonts.Size
+                && NbUserCustomRects(atlas) == 0;
+            if (canReusePreviousAtlas)
+            {
+                if (!gStagingBuild || gStagingBuild->Key != key)
+                {
+                    gStagingBuild.reset(); // waits for an obsolete build
+                    gStagingBuild = StartStagingBuild(atlas, key);
+                }
+                if (gStagingBuild && ApplySnapshot(atlas, gSnapshot))
+                {
+                    gIsRebuildPending = true;
+                    return true;
+                }
+            }
+            gStagingBuild.reset();
+#endif
+
+            // Synchronous build
+            bool success = gDelegateBuilderIO->FontBuilder_Build(atlas);
+            if (success)
+                gSnapshot = TakeSnapshot(atlas);
+            gIsRebuildPending = false;
+            return success;
+        }
+
+        const ImFontBuilderIO gAsyncFontBuilderIO { AsyncFontBuilder_Build };
+    } // anonymous namespace
+
+
+    void InstallAsyncFontRebuild()
+    {
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        if (atlas->FontBuilderIO == &gAsyncFontBuilderIO)
+            return;
+        gDelegateBuilderIO = atlas->FontBuilderIO ? atlas->FontBuilderIO : FontAtlasInternal::DefaultFontBuilderIO();
+        if (gDelegateBuilderIO == nullptr)
+        {
+            fprintf(stderr, "InstallAsyncFontRebuild: no font builder available!\n");
+            return;
+        }
+        atlas->FontBuilderIO = &gAsyncFontBuilderIO;
+        FontAtlasInternal::RegisterDelegatingFontBuilder(&gAsyncFontBuilderIO, "async", gDelegateBuilderIO);
+    }
+
+
+    bool IsFontRebuildPending()
+    {
+        return gIsRebuildPending;
+    }
+
+
+    namespace FontAtlasAsyncRebuildInternal
+    {
+        // Called in PreNewFrame: once the staging atlas is ready, ask HelloImGui to rebuild
+        // the fonts at the frame boundary (the builder will then swap the staging atlas in)
+        void OnPreNewFrame()
+        {
+            if (!gStagingBuild || gSwapRequested || !gStagingBuild->IsDone.load(std::memory_order_acquire))
+                return;
+            auto runnerParams = HelloImGui::GetRunnerParams();
+            if (runnerParams == nullptr)
+                return;
+            auto swapStagingAtlas = []()
+            {
+                ImGui::GetIO().Fonts->ClearTexData();
+                gSwapRequested = false;
+            };
+            auto& loadAdditionalFonts = runnerParams->callbacks.LoadAdditionalFonts;
+            if (loadAdditionalFonts)
+                loadAdditionalFonts = HelloImGui::SequenceFunctions(loadAdditionalFonts, swapStagingAtlas);
+            else
+                loadAdditionalFonts = swapStagingAtlas;
+            gSwapRequested = true;
+        }
+
+        // Called in BeforeExit: waits for the worker thread, and frees the copies
+        void OnExit()
+        {
+            gStagingBuild.reset();
+            gSnapshot = AtlasSnapshot();
+            gIsRebuildPending = false;
+            gSwapRequested = false;
+        }
+    } // namespace FontAtlasAsyncRebuildInternal
+
+} // namespace ImmApp
@@ -0,0 +1,32 @@
+#pragma once
+
+
+namespace ImmApp
+{
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Asynchronous font atlas rebuild
+    //
+    // When the fonts are reloaded after startup (e.g. FontDpiResponsive fonts, when the window
+    // moves to a monitor with a different DPI), rebuilding the atlas synchronously freezes the UI
+    // (for hundreds of milliseconds with the markdown fonts).
+    //
+    // When enabled (AddOnsParams.withAsyncFontRebuild), the glyphs of such rebuilds are rasterized
+    // by a worker thread (with stb_truetype). In the meantime, the fonts are displayed with the glyphs
+    // of the previous atlas, scaled to their new size. The new glyphs are packed into the atlas
+    // at the next frame boundary after the worker is done.
+    //
+    // The first build (at startup) stays synchronous. A copy of the last built atlas is kept in memory.
+    // With FreeType (which allocates through ImGui, and cannot be used outside of the main thread),
+    // the rebuilds stay synchronous.
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+
+    // InstallAsyncFontRebuild: replaces the font builder of ImGui::GetIO().Fonts by a builder
+    // which rebuilds the atlas asynchronously (the previous builder is used for synchronous builds)
+    // (ImmApp::Run calls this automatically if AddOnsParams.withAsyncFontRebuild is true)
+    void InstallAsyncFontRebuild();
+
+    // IsFontRebuildPending returns true while the fonts are displayed with a scaled previous atlas
+    bool IsFontRebuildPending();
+} // namespace ImmApp
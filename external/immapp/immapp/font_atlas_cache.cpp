@@ -0,0 +1,582 @@
+#include "immapp/font_atlas_cache.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#ifdef IMGUI_ENABLE_FREETYPE
+#include "misc/freetype/imgui_freetype.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ImmApp
+{
+    namespace FontAtlasInternal
+    {
+        // Private API, implemented in dynamic_glyphs.cpp
+        bool HasDynamicGlyphs();
+    }
+
+    namespace
+    {
+        constexpr uint32_t kCacheFormatVersion = 1;
+        constexpr char kCacheMagic[4] = { 'I', 'M', 'F', 'A' };
+        constexpr size_t kMaxCacheEntries = 4;
+
+        std::string gCacheFolder;
+        const ImFontBuilderIO* gDelegateBuilderIO = nullptr;
+        FontAtlasCacheStats gFontAtlasCacheStats;
+
+
+        ///////////////////////////////////////////////////////////////////////
+        // Cache key
+        ///////////////////////////////////////////////////////////////////////
+        struct Fnv1aHasher
+        {
+            uint64_t Hash = 14695981039346656037ull;
+
+            void AddBytes(const void* data, size_t size)
+            {
+                const unsigned char* bytes = (const unsigned char*)data;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    Hash ^= bytes[i];
+                    Hash *= 1099511628211ull;
+                }
+            }
+
+            template<typename T> void Add(const T& v) { AddBytes(&v, sizeof(T)); }
+            void AddString(const char* s) { AddBytes(s, strlen(s) + 1); }
+        };
+
+        // The builders which delegate to another builder (parallel, async...) are registered,
+        // so that the key can identify the whole chain, down to the rasterizer (stb_truetype or FreeType)
+        struct DelegatingFontBuilder
+        {
+            const ImFontBuilderIO* BuilderIO;
+            const char* Name;
+            const ImFontBuilderIO* DelegateBuilderIO;
+        };
+        std::vector<DelegatingFontBuilder> gDelegatingFontBuilders;
+
+        void AddBuilderIdentity(Fnv1aHasher* hasher, const ImFontBuilderIO* builderIO)
+        {
+            for (int depth = 0; builderIO != nullptr && depth < 8; ++depth)
+            {
+                auto it = std::find_if(gDelegatingFontBuilders.begin(), gDelegatingFontBuilders.end(),
+                                       [builderIO](const DelegatingFontBuilder& b) { return b.BuilderIO == builderIO; });
+                if (it == gDelegatingFontBuilders.end())
+                    break;
+                hasher->AddString(it->Name);
+                builderIO = it->DelegateBuilderIO;
+            }
+#ifdef IMGUI_ENABLE_FREETYPE
+            if (builderIO == ImGuiFreeType::GetBuilderForFreeType())
+            {
+                hasher->AddString("freetype");
+                return;
+            }
+#endif
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+            if (builderIO == ImFontAtlasGetBuilderForStbTruetype())
+            {
+                hasher->AddString("stb_truetype");
+                return;
+            }
+#endif
+            // An unknown builder: its address is only valid during this run
+            hasher->AddString("custom");
+            hasher->Add((uintptr_t)builderIO);
+        }
+
+        // The content of the font files is hashed once per file, even when it is shared by several configs
+        // (e.g. the markdown fonts at different sizes), and once per run: the hashes are kept by address.
+        // Since the atlas may free a font file and allocate another one at the same address, an entry is
+        // only reused if the size and a sample of the content match.
+        struct FontBlobHash
+        {
+            int Size = 0;
+            uint64_t SampleHash = 0;
+            uint64_t Hash = 0;
+        };
+        std::unordered_map<const void*, FontBlobHash> gFontBlobHashes;
+
+        uint64_t FontBlobSampleHash(const void* data, int size)
+        {
+            constexpr int kNbSamples = 16, kSampleSize = 64;
+            Fnv1aHasher hasher;
+            const unsigned char* bytes = (const unsigned char*)data;
+            for (int i = 0; i < kNbSamples; ++i)
+            {
+                size_t offset = (size_t)size * (size_t)i / kNbSamples;
+                hasher.AddBytes(bytes + offset, std::min((size_t)kSampleSize, (size_t)size - offset));
+            }
+            return hasher.Hash;
+        }
+
+        uint64_t FontBlobHashCached(const void* data, int size, std::unordered_map<const void*, FontBlobHash>* usedHashes)
+        {
+            auto itUsed = usedHashes->find(data);
+            if (itUsed != usedHashes->end() && itUsed->second.Size == size)
+                return itUsed->second.Hash;
+
+            uint64_t sampleHash = FontBlobSampleHash(data, size);
+            auto it = gFontBlobHashes.find(data);
+            FontBlobHash blobHash;
+            if (it != gFontBlobHashes.end() && it->second.Size == size && it->second.SampleHash == sampleHash)
+                blobHash = it->second;
+            else
+            {
+                Fnv1aHasher hasher;
+                hasher.AddBytes(data, (size_t)size);
+                blobHash.Size = size;
+                blobHash.SampleHash = sampleHash;
+                blobHash.Hash = hasher.Hash;
+            }
+            (*usedHashes)[data] = blobHash;
+            return blobHash.Hash;
+        }
+
+        // Main thread only (the font builders are called by ImFontAtlas::Build())
+        uint64_t ComputeAtlasKey(const ImFontAtlas* atlas, const ImFontBuilderIO* builderIO)
+        {
+            Fnv1aHasher hasher;
+            hasher.Add(IMGUI_VERSION_NUM);
+            hasher.Add(sizeof(ImFontGlyph));
+            hasher.Add(kCacheFormatVersion);
+            AddBuilderIdentity(&hasher, builderIO);
+
+            hasher.Add(atlas->Flags);
+            hasher.Add(atlas->TexDesiredWidth);
+            hasher.Add(atlas->TexGlyphPadding);
+            hasher.Add(atlas->FontBuilderFlags);
+
+            // Only the hashes of the font files used by this atlas are kept
+            std::unordered_map<const void*, FontBlobHash> usedFontBlobHashes;
+            for (const ImFontConfig& cfg: atlas->ConfigData)
+            {
+                // Sizes already include the DPI factor (HelloImGui scales them at load time),
+                // and RasterizerDensity handles the remaining DPI related oversampling.
+                hasher.Add(cfg.FontDataSize);
+                hasher.Add(FontBlobHashCached(cfg.FontData, cfg.FontDataSize, &usedFontBlobHashes));
+                hasher.Add(cfg.FontNo);
+                hasher.Add(cfg.SizePixels);
+                hasher.Add(cfg.OversampleH);
+                hasher.Add(cfg.OversampleV);
+                hasher.Add(cfg.PixelSnapH);
+                hasher.Add(cfg.GlyphExtraSpacing);
+                hasher.Add(cfg.GlyphOffset);
+                hasher.Add(cfg.GlyphMinAdvanceX);
+                hasher.Add(cfg.GlyphMaxAdvanceX);
+                hasher.Add(cfg.MergeMode);
+                hasher.Add(cfg.FontBuilderFlags);
+                hasher.Add(cfg.RasterizerMultiply);
+                hasher.Add(cfg.RasterizerDensity);
+                hasher.Add(cfg.EllipsisChar);
+
+                const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : const_cast<ImFontAtlas*>(atlas)->GetGlyphRangesDefault(); // (returns a static array)
+                for (; ranges[0] != 0; ++ranges)
+                    hasher.Add(ranges[0]);
+                hasher.Add((ImWchar)0);
+            }
+            gFontBlobHashes = std::move(usedFontBlobHashes);
+            return hasher.Hash;
+        }
+
+        std::string CacheEntryPath(uint64_t key)
+        {
+            char filename[64];
+            snprintf(filename, sizeof(filename), "%016llx.fontatlas", (unsigned long long)key);
+            return (std::filesystem::path(gCacheFolder) / filename).string();
+        }
+
+
+        ///////////////////////////////////////////////////////////////////////
+        // Serialization
+        ///////////////////////////////////////////////////////////////////////
+        struct BufferWriter
+        {
+            std::vector<char> Data;
+
+            void WriteBytes(const void* data, size_t size)
+            {
+                const char* bytes = (const char*)data;
+                Data.insert(Data.end(), bytes, bytes + size);
+            }
+            template<typename T> void Write(const T& v) { WriteBytes(&v, sizeof(T)); }
+        };
+
+        struct BufferReader
+        {
+            const std::vector<char>& Data;
+            size_t Position = 0;
+            bool Failed = false;
+
+            explicit BufferReader(const std::vector<char>& data) : Data(data) {}
+
+            bool ReadBytes(void* dst, size_t size)
+            {
+                if (Failed || Position + size > Data.size())
+                {
+                    Failed = true;
+                    return false;
+                }
+                memcpy(dst, Data.data() + Position, size);
+                Position += size;
+                return true;
+            }
+            template<typename T> T Read() { T v {}; ReadBytes(&v, sizeof(T)); return v; }
+        };
+
+        // Layout: header, texture size & pixels, custom rects positions, then for each font its metrics and glyphs
+        void SaveAtlasToCache(const ImFontAtlas* atlas, uint64_t key)
+        {
+            // Custom rects added by the user (AddCustomRectXXX) reference user data that we cannot restore
+            if (atlas->CustomRects.Size > 2)
+                return;
+
+            BufferWriter w;
+            w.WriteBytes(kCacheMagic, sizeof(kCacheMagic));
+            w.Write(kCacheFormatVersion);
+            w.Write(key);
+
+            bool useColors = (atlas->TexPixelsRGBA32 != nullptr);
+            w.Write(atlas->TexWidth);
+            w.Write(atlas->TexHeight);
+            w.Write((uint8_t)(useColors ? 1 : 0));
+            w.Write((uint8_t)(atlas->TexPixelsUseColors ? 1 : 0));
+            size_t nbPixels = (size_t)atlas->TexWidth * (size_t)atlas->TexHeight;
+            if (useColors)
+                w.WriteBytes(atlas->TexPixelsRGBA32, nbPixels * 4);
+            else
+                w.WriteBytes(atlas->TexPixelsAlpha8, nbPixels);
+
+            w.Write(atlas->CustomRects.Size);
+            for (const ImFontAtlasCustomRect& rect: atlas->CustomRects)
+            {
+                w.Write(rect.Width);
+                w.Write(rect.Height);
+                w.Write(rect.X);
+                w.Write(rect.Y);
+            }
+
+            w.Write(atlas->Fonts.Size);
+            for (const ImFont* font: atlas->Fonts)
+            {
+                w.Write(font->Ascent);
+                w.Write(font->Descent);
+                w.Write(font->MetricsTotalSurface);
+                w.Write(font->Glyphs.Size);
+                w.WriteBytes(font->Glyphs.Data, (size_t)font->Glyphs.Size * sizeof(ImFontGlyph));
+            }
+
+            std::error_code ec;
+            std::filesystem::create_directories(gCacheFolder, ec);
+
+            // Write to a temporary file, then rename: concurrent instances never see a partial entry
+            std::string path = CacheEntryPath(key);
+            std::string tmpPath = path + ".tmp";
+            {
+                std::ofstream ofs(tmpPath, std::ios::binary);
+                if (!ofs.good())
+                {
+                    fprintf(stderr, "FontAtlasCache: could not write %s\n", tmpPath.c_str());
+                    return;
+                }
+                ofs.write(w.Data.data(), (std::streamsize)w.Data.size());
+            }
+            std::filesystem::rename(tmpPath, path, ec);
+            if (ec)
+                std::filesystem::remove(tmpPath, ec);
+        }
+
+        // Keep only the most recent entries (e.g. one per DPI factor)
+        void PruneCacheFolder()
+        {
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            std::vector<fs::directory_entry> entries;
+            for (const auto& entry: fs::directory_iterator(gCacheFolder, ec))
+                if (entry.path().extension() == ".fontatlas")
+                    entries.push_back(entry);
+            if (entries.size() <= kMaxCacheEntries)
+                return;
+
+            std::sort(entries.begin(), entries.end(), [](const fs::directory_entry& a, const fs::directory_entry& b) {
+                std::error_code ec_;
+                return a.last_write_time(ec_) > b.last_write_time(ec_);
+            });
+            for (size_t i = kMaxCacheEntries; i < entries.size(); ++i)
+                fs::remove(entries[i].path(), ec);
+        }
+
+        bool ReadFile(const std::string& path, std::vector<char>* outData)
+        {
+            std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+            if (!ifs.good())
+                return false;
+            std::streamsize size = ifs.tellg();
+            if (size <= 0)
+                return false;
+            ifs.seekg(0, std::ios::beg);
+            outData->resize((size_t)size);
+            return (bool)ifs.read(outData->data(), size);
+        }
+
+        // Restores the atlas from the cache. Returns false (and leaves the atlas to be built normally) on failure
+        bool LoadAtlasFromCache(ImFontAtlas* atlas, uint64_t key)
+        {
+            if (atlas->CustomRects.Size > 2)
+                return false;
+
+            std::vector<char> data;
+            if (!ReadFile(CacheEntryPath(key), &data))
+                return false;
+
+            BufferReader r(data);
+            char magic[4];
+            r.ReadBytes(magic, sizeof(magic));
+            if (r.Failed || memcmp(magic, kCacheMagic, sizeof(magic)) != 0)
+                return false;
+            if (r.Read<uint32_t>() != kCacheFormatVersion || r.Read<uint64_t>() != key)
+                return false;
+
+            int texWidth = r.Read<int>();
+            int texHeight = r.Read<int>();
+            bool useColors = r.Read<uint8_t>() != 0;
+            bool texPixelsUseColors = r.Read<uint8_t>() != 0;
+            if (r.Failed || texWidth <= 0 || texHeight <= 0)
+                return false;
+            size_t pixelsSize = (size_t)texWidth * (size_t)texHeight * (useColors ? 4 : 1);
+            if (r.Position + pixelsSize > data.size())
+                return false;
+            const char* pixels = data.data() + r.Position;
+            r.Position += pixelsSize;
+
+            // Registers the default custom rects (mouse cursors, lines), whose positions we will restore
+            ImFontAtlasBuildInit(atlas);
+            int nbCustomRects = r.Read<int>();
+            if (r.Failed || nbCustomRects != atlas->CustomRects.Size)
+                return false;
+            std::vector<ImFontAtlasCustomRect> customRects(atlas->CustomRects.begin(), atlas->CustomRects.end());
+            for (auto& rect: customRects)
+            {
+                auto width = r.Read<unsigned short>();
+                auto height = r.Read<unsigned short>();
+                rect.X = r.Read<unsigned short>();
+                rect.Y = r.Read<unsigned short>();
+                if (width != rect.Width || height != rect.Height)
+                    return false;
+            }
+
+            int nbFonts = r.Read<int>();
+            if (r.Failed || nbFonts != atlas->Fonts.Size)
+                return false;
+            struct FontData { float Ascent, Descent; int MetricsTotalSurface; ImVector<ImFontGlyph> Glyphs; };
+            std::vector<FontData> fontsData((size_t)nbFonts);
+            for (auto& fontData: fontsData)
+            {
+                fontData.Ascent = r.Read<float>();
+                fontData.Descent = r.Read<float>();
+                fontData.MetricsTotalSurface = r.Read<int>();
+                int nbGlyphs = r.Read<int>();
+                if (r.Failed || nbGlyphs < 0)
+                    return false;
+                fontData.Glyphs.resize(nbGlyphs);
+                r.ReadBytes(fontData.Glyphs.Data, (size_t)nbGlyphs * sizeof(ImFontGlyph));
+            }
+            if (r.Failed)
+                return false;
+
+            // The entry is valid: we can now modify the atlas
+            atlas->TexID = (ImTextureID)0;
+            atlas->ClearTexData();
+            atlas->TexWidth = texWidth;
+            atlas->TexHeight = texHeight;
+            atlas->TexUvScale = ImVec2(1.0f / (float)texWidth, 1.0f / (float)texHeight);
+            atlas->TexPixelsUseColors = texPixelsUseColors;
+            if (useColors)
+            {
+                atlas->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(pixelsSize);
+                memcpy(atlas->TexPixelsRGBA32, pixels, pixelsSize);
+            }
+            else
+            {
+                atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(pixelsSize);
+                memcpy(atlas->TexPixelsAlpha8, pixels, pixelsSize);
+            }
+            for (int i = 0; i < atlas->CustomRects.Size; ++i)
+                atlas->CustomRects[i] = customRects[(size_t)i];
+
+            // Setup the fonts, as the builders do (merged configs only increment ConfigDataCount)
+            for (int i = 0; i < atlas->ConfigData.Size; ++i)
+            {
+                ImFontConfig& cfg = atlas->ConfigData[i];
+                ImFont* font = cfg.DstFont;
+                int fontIdx = 0;
+                while (fontIdx < atlas->Fonts.Size && atlas->Fonts[fontIdx] != font)
+                    ++fontIdx;
+                IM_ASSERT(fontIdx < atlas->Fonts.Size);
+                const FontData& fontData = fontsData[(size_t)fontIdx];
+                ImFontAtlasBuildSetupFont(atlas, font, &cfg, fontData.Ascent, fontData.Descent);
+            }
+            for (int i = 0; i < atlas->Fonts.Size; ++i)
+            {
+                ImFont* font = atlas->Fonts[i];
+                font->Glyphs = fontsData[(size_t)i].Glyphs;
+                font->MetricsTotalSurface = fontsData[(size_t)i].MetricsTotalSurface;
+                font->DirtyLookupTables = true;
+            }
+
+            // Renders the default texture data (white pixel, cursors, lines) & builds the lookup tables
+            ImFontAtlasBuildFinish(atlas);
+            return true;
+        }
+
+
+        ///////////////////////////////////////////////////////////////////////
+        // Caching builder
+        ///////////////////////////////////////////////////////////////////////
+        bool CachingFontBuilder_Build(ImFontAtlas* atlas)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto onExit = [&start]() {
+                gFontAtlasCacheStats.LastBuildSeconds =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            };
+
+            IM_ASSERT(atlas->ConfigData.Size > 0);
+            IM_ASSERT(gDelegateBuilderIO != nullptr);
+            // Atlases with glyphs loaded on demand would write a new cache file for each batch of glyphs
+            if (FontAtlasInternal::HasDynamicGlyphs())
+            {
+                bool success = gDelegateBuilderIO->FontBuilder_Build(atlas);
+                onExit();
+                return success;
+            }
+
+            uint64_t key = ComputeAtlasKey(atlas, gDelegateBuilderIO);
+            if (LoadAtlasFromCache(atlas, key))
+            {
+                ++gFontAtlasCacheStats.NbHits;
+                onExit();
+                return true;
+            }
+
+            ++gFontAtlasCacheStats.NbMisses;
+            bool success = gDelegateBuilderIO->FontBuilder_Build(atlas);
+            if (success)
+            {
+                SaveAtlasToCache(atlas, key);
+                PruneCacheFolder();
+            }
+            onExit();
+            return success;
+        }
+
+        const ImFontBuilderIO gCachingFontBuilderIO { CachingFontBuilder_Build };
+    } // anonymous namespace
+
+
+    namespace FontAtlasInternal
+    {
+        // The builder used by ImFontAtlas::Build() when FontBuilderIO is null
+        const ImFontBuilderIO* DefaultFontBuilderIO()
+        {
+#ifdef IMGUI_ENABLE_FREETYPE
+            return ImGuiFreeType::GetBuilderForFreeType();
+#elif defined(IMGUI_ENABLE_STB_TRUETYPE)
+            return ImFontAtlasGetBuilderForStbTruetype();
+#else
+            return nullptr;
+#endif
+        }
+
+        // A hash of all the inputs of the atlas build (including the builder)
+        uint64_t AtlasKey(const ImFontAtlas* atlas)
+        {
+            return ComputeAtlasKey(atlas, atlas->FontBuilderIO ? atlas->FontBuilderIO : DefaultFontBuilderIO());
+        }
+
+        // Registers a builder which delegates to another builder (see AddBuilderIdentity)
+        void RegisterDelegatingFontBuilder(const ImFontBuilderIO* builderIO, const char* name, const ImFontBuilderIO* delegateBuilderIO)
+        {
+            for (auto& builder: gDelegatingFontBuilders)
+            {
+                if (builder.BuilderIO == builderIO)
+                {
+                    builder.DelegateBuilderIO = delegateBuilderIO;
+                    return;
+                }
+            }
+            gDelegatingFontBuilders.push_back({ builderIO, name, delegateBuilderIO });
+        }
+
+        // The builder at the end of the delegation chain (i.e. the rasterizer)
+        const ImFontBuilderIO* BaseFontBuilderIO(const ImFontBuilderIO* builderIO)
+        {
+            for (int depth = 0; builderIO != nullptr && depth < 8; ++depth)
+            {
+                auto it = std::find_if(gDelegatingFontBuilders.begin(), gDelegatingFontBuilders.end(),
+                                       [builderIO](const DelegatingFontBuilder& b) { return b.BuilderIO == builderIO; });
+                if (it == gDelegatingFontBuilders.end())
+                    break;
+                builderIO = it->DelegateBuilderIO;
+            }
+            return builderIO;
+        }
+    }
+
+
+    void InstallFontAtlasCache(const std::string& cacheFolder)
+    {
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        if (atlas->FontBuilderIO == &gCachingFontBuilderIO)
+        {
+            gCacheFolder = cacheFolder;
+            return;
+        }
+        gDelegateBuilderIO = atlas->FontBuilderIO ? atlas->FontBuilderIO : FontAtlasInternal::DefaultFontBuilderIO();
+        if (gDelegateBuilderIO == nullptr)
+        {
+            fprintf(stderr, "InstallFontAtlasCache: no font builder available!\n");
+            return;
+        }
+        gCacheFolder = cacheFolder;
+        atlas->FontBuilderIO = &gCachingFontBuilderIO;
+        FontAtlasInternal::RegisterDelegatingFontBuilder(&gCachingFontBuilderIO, "cache", gDelegateBuilderIO);
+    }
+
+
+    std::string FontAtlasCacheFolder(const HelloImGui::RunnerParams& runnerParams)
+    {
+        // The ini location is usually of the form path/to/your/app.ini
+        // => we replace it with path/to/your/app.font_atlas_cache/
+        std::filesystem::path folder = HelloImGui::IniSettingsLocation(runnerParams);
+        folder.replace_extension(".font_atlas_cache");
+        return folder.string();
+    }
+
+
+    void DeleteFontAtlasCache(const HelloImGui::RunnerParams& runnerParams)
+    {
+        std::string folder = FontAtlasCacheFolder(runnerParams);
+        std::error_code ec;
+        std::filesystem::remove_all(folder, ec);
+        if (ec)
+            fprintf(stderr, "DeleteFontAtlasCache: could not delete %s\n", folder.c_str());
+    }
+
+
+    FontAtlasCacheStats GetFontAtlasCacheStats()
+    {
+        return gFontAtlasCacheStats;
+    }
+
+} // namespace ImmApp
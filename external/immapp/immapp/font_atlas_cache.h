@@ -0,0 +1,44 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+#include <string>
+
+
+namespace ImmApp
+{
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Font atlas disk cache
+    //
+    // Rasterizing the fonts (especially with the many markdown font variants) is one of the
+    // most expensive steps of the application startup. When enabled (AddOnsParams.withFontAtlasCache),
+    // the baked atlas (pixels + glyph tables) is saved to disk, and reloaded at the next launches.
+    //
+    // The cache entry is keyed by a hash of the font files content, sizes (which include the DPI factor),
+    // glyph ranges, rasterizer options, ImGui version and glyph layout: any change triggers a rebuild.
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+
+    struct FontAtlasCacheStats
+    {
+        // Number of atlas builds served from the cache
+        int NbHits = 0;
+        // Number of atlas builds which required a rasterization
+        int NbMisses = 0;
+        // Duration of the last atlas build (in seconds), whether from the cache or not
+        double LastBuildSeconds = 0.;
+    };
+
+    // InstallFontAtlasCache: replaces the font builder of ImGui::GetIO().Fonts by a caching builder
+    // which stores its entries in cacheFolder.
+    // (ImmApp::Run calls this automatically if AddOnsParams.withFontAtlasCache is true)
+    void InstallFontAtlasCache(const std::string& cacheFolder);
+
+    // FontAtlasCacheFolder returns the folder where the font atlas cache is stored
+    // (next to the ini settings file)
+    std::string FontAtlasCacheFolder(const HelloImGui::RunnerParams& runnerParams);
+
+    // DeleteFontAtlasCache deletes the font atlas cache folder
+    void DeleteFontAtlasCache(const HelloImGui::RunnerParams& runnerParams);
+
+    FontAtlasCacheStats GetFontAtlasCacheStats();
+} // namespace ImmApp
@@ -0,0 +1,97 @@
+#include "immapp/font_atlas_parallel_build.h"
+#include "immapp/internal/font_atlas_rasterizer.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define IMMAPP_FONT_BUILD_NO_THREADS
+#endif
+
+
+namespace ImmApp
+{
+    namespace FontAtlasInternal
+    {
+        // Private API, implemented in font_atlas_cache.cpp
+        const ImFontBuilderIO* DefaultFontBuilderIO();
+        void RegisterDelegatingFontBuilder(const ImFontBuilderIO* builderIO, const char* name, const ImFontBuilderIO* delegateBuilderIO);
+    }
+
+    namespace
+    {
+        const ImFontBuilderIO* gDelegateBuilderIO = nullptr;
+        int gNbThreads = 0;
+
+        // The workers only rasterize (they do not call ImGui, whose allocations are not thread safe),
+        // and read the font data of the atlas, which is not modified until the build returns
+        void RasterizeFontGroups(std::vector<FontAtlasInternal::RasterizerFontGroup>& groups)
+        {
+#ifndef IMMAPP_FONT_BUILD_NO_THREADS
+            int nbThreads = gNbThreads > 0 ? gNbThreads : (int)std::thread::hardware_concurrency();
+            nbThreads = std::min(nbThreads, (int)groups.size());
+            if (nbThreads > 1)
+            {
+                std::atomic<int> nextGroup { 0 };
+                auto worker = [&]() {
+                    for (int i = nextGroup++; i < (int)groups.size(); i = nextGroup++)
+                        FontAtlasInternal::RasterizeFontGroup(&groups[(size_t)i]);
+                };
+                std::vector<std::thread> threads;
+                for (int i = 0; i < nbThreads - 1; ++i)
+                    threads.emplace_back(worker);
+                worker();
+                for (auto& thread: threads)
+                    thread.join();
+                return;
+            }
+#endif
+            for (auto& group: groups)
+                FontAtlasInternal::RasterizeFontGroup(&group);
+        }
+
+        bool ParallelFontBuilder_Build(ImFontAtlas* atlas)
+        {
+            IM_ASSERT(gDelegateBuilderIO != nullptr);
+            IM_ASSERT(atlas->ConfigData.Size > 0);
+            // Only stb_truetype can be used outside of ImGui (FreeType allocates through ImGui)
+            if (!FontAtlasInternal::CanRasterizeOffThread(gDelegateBuilderIO))
+                return gDelegateBuilderIO->FontBuilder_Build(atlas);
+            std::vector<FontAtlasInternal::RasterizerFontGroup> groups = FontAtlasInternal::MakeRasterizerFontGroups(atlas);
+            if (groups.size() < 2)
+                return gDelegateBuilderIO->FontBuilder_Build(atlas);
+
+            RasterizeFontGroups(groups);
+            if (FontAtlasInternal::AssembleRasterizedAtlas(atlas, groups))
+                return true;
+
+            // Fallback to a serial build
+            return gDelegateBuilderIO->FontBuilder_Build(atlas);
+        }
+
+        const ImFontBuilderIO gParallelFontBuilderIO { ParallelFontBuilder_Build };
+    } // anonymous namespace
+
+
+    void InstallParallelFontBuilder(int nbThreads)
+    {
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        gNbThreads = nbThreads;
+        if (atlas->FontBuilderIO == &gParallelFontBuilderIO)
+            return;
+        gDelegateBuilderIO = atlas->FontBuilderIO ? atlas->FontBuilderIO : FontAtlasInternal::DefaultFontBuilderIO();
+        if (gDelegateBuilderIO == nullptr)
+        {
+            fprintf(stderr, "InstallParallelFontBuilder: no font builder available!\n");
+            return;
+        }
+        atlas->FontBuilderIO = &gParallelFontBuilderIO;
+        FontAtlasInternal::RegisterDelegatingFontBuilder(&gParallelFontBuilderIO, "parallel", gDelegateBuilderIO);
+    }
+
+} // namespace ImmApp
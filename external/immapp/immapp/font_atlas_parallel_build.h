@@ -0,0 +1,25 @@
+#pragma once
+
+
+namespace ImmApp
+{
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Parallel font atlas build
+    //
+    // When enabled (AddOnsParams.withParallelFontBuild), the independent fonts of the atlas
+    // (i.e. each font, together with the fonts merged into it) are rasterized concurrently
+    // with stb_truetype, each into a private bitmap (the font files are shared, not copied).
+    // Their glyphs are then packed into the final atlas in a fixed order, on the main thread,
+    // so that the final atlas does not depend on the threads scheduling.
+    //
+    // With FreeType (which allocates through ImGui, and cannot be used by several threads),
+    // the atlas is built serially.
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+
+    // InstallParallelFontBuilder: replaces the font builder of ImGui::GetIO().Fonts by a builder
+    // which rasterizes the fonts on nbThreads threads (0 = number of hardware threads).
+    // (ImmApp::Run calls this automatically if AddOnsParams.withParallelFontBuild is true)
+    void InstallParallelFontBuilder(int nbThreads = 0);
+} // namespace ImmApp
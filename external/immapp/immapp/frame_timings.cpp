@@ -0,0 +1,353 @@
+#include "immapp/frame_timings.h"
+#include "hello_imgui/hello_imgui.h"
+#include "imgui.h"
+#ifdef IMGUI_BUNDLE_WITH_IMPLOT
+#include "implot/implot.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        constexpr int kNbPhases = (int)FramePhase::Count;
+        constexpr int kRingCapacity = 512;
+
+        using FrameSample = std::array<float, kNbPhases>; // durations in ms, indexed by FramePhase
+
+        float ElapsedMs(Clock::time_point start, Clock::time_point end)
+        {
+            return std::chrono::duration<float, std::milli>(end - start).count();
+        }
+
+        // Single producer ring buffer: only the main thread writes (once per frame), and it never waits for the readers,
+        // which may be on any thread.
+        // Each slot has a sequence counter (odd while the slot is being written), from which a reader knows
+        // whether it read the expected frame: a sample overwritten during its copy is skipped (the reader was late).
+        struct FrameTimingsSlot
+        {
+            std::atomic<uint64_t> Sequence { 0 };   // 2 * frameIndex + 2 once the frame frameIndex was written
+            std::array<std::atomic<float>, kNbPhases> Values {};
+        };
+
+        struct FrameTimingsRing
+        {
+            std::array<FrameTimingsSlot, kRingCapacity> Slots;
+            std::atomic<uint64_t> NbWritten { 0 };
+            std::atomic<uint64_t> ClearedAt { 0 };  // Written by ClearFrameTimings (the writer never changes it)
+
+            void Push(const FrameSample& sample)
+            {
+                uint64_t n = NbWritten.load(std::memory_order_relaxed);
+                FrameTimingsSlot& slot = Slots[n % kRingCapacity];
+                slot.Sequence.store(2 * n + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                for (size_t i = 0; i < sample.size(); ++i)
+                    slot.Values[i].store(sample[i], std::memory_order_relaxed);
+                slot.Sequence.store(2 * n + 2, std::memory_order_release);
+                NbWritten.store(n + 1, std::memory_order_release);
+            }
+
+            std::vector<FrameSample> Snapshot() const
+            {
+                uint64_t n = NbWritten.load(std::memory_order_acquire);
+                uint64_t first = std::max(n - std::min<uint64_t>(n, kRingCapacity - 1), ClearedAt.load(std::memory_order_acquire));
+                std::vector<FrameSample> r;
+                r.reserve((size_t)(n - std::min(first, n)));
+                for (uint64_t i = first; i < n; ++i)
+                {
+                    const FrameTimingsSlot& slot = Slots[i % kRingCapacity];
+                    if (slot.Sequence.load(std::memory_order_acquire) != 2 * i + 2)
+                        continue;
+                    FrameSample sample;
+                    for (size_t j = 0; j < sample.size(); ++j)
+                        sample[j] = slot.Values[j].load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.Sequence.load(std::memory_order_relaxed) != 2 * i + 2)
+                        continue;
+                    r.push_back(sample);
+                }
+                return r;
+            }
+
+            uint64_t GetNbRecordedFrames() const
+            {
+                uint64_t n = NbWritten.load(std::memory_order_acquire);
+                return n - std::min(n, ClearedAt.load(std::memory_order_acquire));
+            }
+
+            void Clear()
+            {
+                ClearedAt.store(NbWritten.load(std::memory_order_acquire), std::memory_order_release);
+            }
+        };
+
+        // State of the frame being measured (main thread only)
+        struct FrameTimingsState
+        {
+            FrameSample Current {};
+            bool FrameStarted = false;
+            bool HasBeforeRenderEnd = false;
+            bool HasAfterSwapEnd = false;
+            Clock::time_point BeforeRenderEnd;
+            Clock::time_point AfterSwapEnd;
+        };
+
+        FrameTimingsRing gFrameTimingsRing;
+        FrameTimingsState gFrameTimingsState;
+
+        void AddPhaseDuration(FramePhase phase, float durationMs)
+        {
+            gFrameTimingsState.Current[(size_t)phase] += durationMs;
+        }
+
+        // Returns a function that calls fn and adds its duration to the given phase
+        HelloImGui::VoidFunction TimedFunction(FramePhase phase, const HelloImGui::VoidFunction& fn)
+        {
+            return [phase, fn]()
+            {
+                auto start = Clock::now();
+                if (fn)
+                    fn();
+                AddPhaseDuration(phase, ElapsedMs(start, Clock::now()));
+            };
+        }
+
+        float Percentile(std::vector<float>& values, float p)
+        {
+            // values is partially reordered
+            size_t idx = (size_t)(p * (float)(values.size() - 1) + 0.5f);
+            std::nth_element(values.begin(), values.begin() + (ptrdiff_t)idx, values.end());
+            return values[idx];
+        }
+
+        std::vector<FramePhaseStats> ComputeStats(const std::vector<FrameSample>& samples)
+        {
+            std::vector<FramePhaseStats> r;
+            if (samples.empty())
+                return r;
+
+            std::vector<float> values(samples.size());
+            for (int phaseIdx = 0; phaseIdx < kNbPhases; ++phaseIdx)
+            {
+                float sum = 0.f, maxValue = 0.f;
+                for (size_t i = 0; i < samples.size(); ++i)
+                {
+                    values[i] = samples[i][phaseIdx];
+                    sum += values[i];
+                    maxValue = std::max(maxValue, values[i]);
+                }
+
+                FramePhaseStats stats;
+                stats.Phase = (FramePhase)phaseIdx;
+                stats.MeanMs = sum / (float)values.size();
+                stats.MaxMs = maxValue;
+                stats.P50Ms = Percentile(values, 0.50f);
+                stats.P95Ms = Percentile(values, 0.95f);
+                stats.P99Ms = Percentile(values, 0.99f);
+                r.push_back(stats);
+            }
+            return r;
+        }
+
+        std::vector<float> PhaseHistory(const std::vector<FrameSample>& samples, FramePhase phase)
+        {
+            std::vector<float> r(samples.size());
+            for (size_t i = 0; i < samples.size(); ++i)
+                r[i] = samples[i][(size_t)phase];
+            return r;
+        }
+    } // anonymous namespace
+
+
+    std::string FramePhaseName(FramePhase phase)
+    {
+        switch (phase)
+        {
+            case FramePhase::PreNewFrame: return "PreNewFrame";
+            case FramePhase::ShowGui: return "ShowGui";
+            case FramePhase::DockableWindows: return "DockableWindows";
+            case FramePhase::CustomBackground: return "CustomBackground";
+            case FramePhase::BeforeImGuiRender: return "BeforeImGuiRender";
+            case FramePhase::RenderAndSwap: return "Render+Swap";
+            case FramePhase::AfterSwap: return "AfterSwap";
+            case FramePhase::Idle: return "Idle/Events";
+            default: return "Unknown";
+        }
+    }
+
+
+    std::vector<FramePhaseStats> GetFrameTimingsStats()
+    {
+        return ComputeStats(gFrameTimingsRing.Snapshot());
+    }
+
+
+    std::vector<float> GetFrameTimingsHistory(FramePhase phase)
+    {
+        IM_ASSERT(phase < FramePhase::Count);
+        return PhaseHistory(gFrameTimingsRing.Snapshot(), phase);
+    }
+
+
+    int GetFrameTimingsNbRecordedFrames()
+    {
+        return (int)gFrameTimingsRing.GetNbRecordedFrames();
+    }
+
+
+    int FrameTimingsCapacity()
+    {
+        return kRingCapacity - 1;
+    }
+
+
+    void ClearFrameTimings()
+    {
+        gFrameTimingsRing.Clear();
+    }
+
+
+    void ShowFrameTimingsWindow(bool* p_open)
+    {
+        ImGui::SetNextWindowSize(ImVec2(ImGui::GetFontSize() * 30.f, ImGui::GetFontSize() * 26.f), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Frame timings", p_open))
+        {
+            ImGui::End();
+            return;
+        }
+
+        // A single snapshot is used for the table and the plot
+        std::vector<FrameSample> samples = gFrameTimingsRing.Snapshot();
+        std::vector<FramePhaseStats> allStats = ComputeStats(samples);
+        if (allStats.empty())
+        {
+            ImGui::TextWrapped("No frame timings recorded (set AddOnsParams.withFrameTimings = true)");
+            ImGui::End();
+            return;
+        }
+
+        ImGui::Text("Last %d frames (ms)", (int)samples.size());
+        ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+        if (ImGui::BeginTable("FrameTimingsTable", 6, tableFlags))
+        {
+            ImGui::TableSetupColumn("Phase");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("mean");
+            ImGui::TableSetupColumn("max");
+            ImGui::TableHeadersRow();
+            for (const auto& stats: allStats)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(FramePhaseName(stats.Phase).c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.P50Ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.P95Ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.P99Ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.MeanMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.MaxMs);
+            }
+            ImGui::EndTable();
+        }
+
+#ifdef IMGUI_BUNDLE_WITH_IMPLOT
+        if (ImPlot::GetCurrentContext() != nullptr)
+        {
+            if (ImPlot::BeginPlot("##FrameTimingsPlot", ImVec2(-1.f, -1.f)))
+            {
+                ImPlot::SetupAxes("frame", "ms", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+                ImPlot::SetupLegend(ImPlotLocation_NorthWest);
+                for (int phaseIdx = 0; phaseIdx < kNbPhases; ++phaseIdx)
+                {
+                    // Idle time usually dwarfs the other phases: hidden by default
+                    if ((FramePhase)phaseIdx == FramePhase::Idle)
+                        ImPlot::HideNextItem(true, ImPlotCond_Once);
+                    std::vector<float> history = PhaseHistory(samples, (FramePhase)phaseIdx);
+                    std::string name = FramePhaseName((FramePhase)phaseIdx);
+                    ImPlot::PlotLine(name.c_str(), history.data(), (int)history.size());
+                }
+                ImPlot::EndPlot();
+            }
+        }
+#endif
+        ImGui::End();
+    }
+
+
+    namespace FrameTimingsInternal
+    {
+        void InstallFrameTimingsCallbacks(HelloImGui::RunnerParams& runnerParams)
+        {
+            auto& callbacks = runnerParams.callbacks;
+
+            // PreNewFrame starts a new frame: commit the previous one
+            auto fnStartFrame = []()
+            {
+                auto now = Clock::now();
+                auto& state = gFrameTimingsState;
+                if (state.FrameStarted)
+                {
+                    if (state.HasAfterSwapEnd)
+                        AddPhaseDuration(FramePhase::Idle, ElapsedMs(state.AfterSwapEnd, now));
+                    gFrameTimingsRing.Push(state.Current);
+                }
+                state.Current.fill(0.f);
+                state.FrameStarted = true;
+                state.HasBeforeRenderEnd = false;
+                state.HasAfterSwapEnd = false;
+            };
+            callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+                fnStartFrame,
+                TimedFunction(FramePhase::PreNewFrame, callbacks.PreNewFrame));
+
+            callbacks.ShowGui = TimedFunction(FramePhase::ShowGui, callbacks.ShowGui);
+            callbacks.CustomBackground = TimedFunction(FramePhase::CustomBackground, callbacks.CustomBackground);
+
+            // Note: only the dockable windows known at startup are timed
+            for (auto& dockableWindow: runnerParams.dockingParams.dockableWindows)
+                dockableWindow.GuiFunction = TimedFunction(FramePhase::DockableWindows, dockableWindow.GuiFunction);
+
+            auto fnBeforeImGuiRender = callbacks.BeforeImGuiRender;
+            callbacks.BeforeImGuiRender = [fnBeforeImGuiRender]()
+            {
+                auto start = Clock::now();
+                if (fnBeforeImGuiRender)
+                    fnBeforeImGuiRender();
+                auto end = Clock::now();
+                AddPhaseDuration(FramePhase::BeforeImGuiRender, ElapsedMs(start, end));
+                gFrameTimingsState.BeforeRenderEnd = end;
+                gFrameTimingsState.HasBeforeRenderEnd = true;
+            };
+
+            // Render + swap is what remains between BeforeImGuiRender and AfterSwap,
+            // once CustomBackground (which is called in between) is removed.
+            auto fnAfterSwap = callbacks.AfterSwap;
+            callbacks.AfterSwap = [fnAfterSwap]()
+            {
+                auto& state = gFrameTimingsState;
+                auto start = Clock::now();
+                if (state.HasBeforeRenderEnd)
+                {
+                    float renderMs = ElapsedMs(state.BeforeRenderEnd, start)
+                                     - state.Current[(size_t)FramePhase::CustomBackground];
+                    AddPhaseDuration(FramePhase::RenderAndSwap, std::max(renderMs, 0.f));
+                }
+                if (fnAfterSwap)
+                    fnAfterSwap();
+                auto end = Clock::now();
+                AddPhaseDuration(FramePhase::AfterSwap, ElapsedMs(start, end));
+                state.AfterSwapEnd = end;
+                state.HasAfterSwapEnd = true;
+            };
+        }
+    } // namespace FrameTimingsInternal
+
+} // namespace ImmApp
@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <vector>
+
+
+namespace ImmApp
+{
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Frame timings: per phase breakdown of the time spent in each frame
+    //
+    // Enable it with AddOnsParams.withFrameTimings = true. ImmApp::Run will then time
+    // each phase of the runner loop, and store the results in a ring buffer
+    // (the writer is the main thread and never blocks, readers may be on any thread).
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+
+    enum class FramePhase
+    {
+        // callbacks.PreNewFrame
+        PreNewFrame = 0,
+        // callbacks.ShowGui (excluding the dockable windows)
+        ShowGui,
+        // The GuiFunction of all the dockable windows
+        DockableWindows,
+        // callbacks.CustomBackground
+        CustomBackground,
+        // callbacks.BeforeImGuiRender
+        BeforeImGuiRender,
+        // ImGui::Render + backend rendering + swap buffers (inferred from the surrounding callbacks)
+        RenderAndSwap,
+        // callbacks.AfterSwap
+        AfterSwap,
+        // Events polling + idle sleep (time between AfterSwap and the next PreNewFrame)
+        Idle,
+
+        Count
+    };
+
+    // FramePhaseName returns a displayable name for a phase
+    std::string FramePhaseName(FramePhase phase);
+
+    // Statistics for a phase, computed on the frames stored in the ring buffer (all durations in milliseconds)
+    struct FramePhaseStats
+    {
+        FramePhase Phase = FramePhase::PreNewFrame;
+        float P50Ms = 0.f;
+        float P95Ms = 0.f;
+        float P99Ms = 0.f;
+        float MeanMs = 0.f;
+        float MaxMs = 0.f;
+    };
+
+    // GetFrameTimingsStats returns the statistics for each phase (in the order of FramePhase)
+    // (returns an empty vector if no frame was recorded)
+    std::vector<FramePhaseStats> GetFrameTimingsStats();
+
+    // GetFrameTimingsHistory returns the durations (in ms) of a phase, for the recorded frames (oldest first)
+    std::vector<float> GetFrameTimingsHistory(FramePhase phase);
+
+    // GetFrameTimingsNbRecordedFrames returns the total number of recorded frames since the app start
+    // (the ring buffer only keeps the last FrameTimingsCapacity() frames)
+    int GetFrameTimingsNbRecordedFrames();
+    int FrameTimingsCapacity();
+
+    // ClearFrameTimings clears the ring buffer
+    void ClearFrameTimings();
+
+    // ShowFrameTimingsWindow: displays a window with p50/p95/p99 per phase,
+    // and a plot of the recent history (if ImPlot is available)
+    void ShowFrameTimingsWindow(bool* p_open = nullptr);
+} // namespace ImmApp
@@ -1,3 +1,10 @@
 #pragma once
 #include "immapp/runner.h"
 #include "immapp/clock.h"
+#include "immapp/frame_timings.h"
+#include "immapp/redraw.h"
+#include "immapp/startup_timeline.h"
+#include "immapp/font_atlas_cache.h"
+#include "immapp/font_atlas_parallel_build.h"
+#include "immapp/dynamic_glyphs.h"
+#include "immapp/font_atlas_async_rebuild.h"
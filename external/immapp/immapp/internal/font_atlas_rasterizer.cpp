@@ -0,0 +1,439 @@
+#include "immapp/internal/font_atlas_rasterizer.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+// stb_rect_pack & stb_truetype, included as in imgui_draw.cpp, with one difference:
+// STBTT_malloc / STBTT_free are not redefined to IM_ALLOC / IM_FREE, so that the rasterization
+// can run on a worker thread (the default implementation uses malloc / free)
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-function"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+
+#ifdef IMGUI_STB_NAMESPACE
+namespace IMGUI_STB_NAMESPACE
+{
+#endif
+
+#ifndef STB_RECT_PACK_IMPLEMENTATION
+#ifndef IMGUI_DISABLE_STB_RECT_PACK_IMPLEMENTATION
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#endif
+#endif
+#ifdef IMGUI_STB_RECT_PACK_FILENAME
+#include IMGUI_STB_RECT_PACK_FILENAME
+#else
+#include "imstb_rectpack.h"
+#endif
+
+#ifndef STB_TRUETYPE_IMPLEMENTATION
+#ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#else
+#define STBTT_DEF extern
+#endif
+#endif
+#ifdef IMGUI_STB_TRUETYPE_FILENAME
+#include IMGUI_STB_TRUETYPE_FILENAME
+#else
+#include "imstb_truetype.h"
+#endif
+
+#ifdef IMGUI_STB_NAMESPACE
+} // namespace IMGUI_STB_NAMESPACE
+using namespace IMGUI_STB_NAMESPACE;
+#endif
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#endif // #ifdef IMGUI_ENABLE_STB_TRUETYPE
+
+
+namespace ImmApp
+{
+    namespace FontAtlasInternal
+    {
+        // Private API, implemented in font_atlas_cache.cpp
+        const ImFontBuilderIO* BaseFontBuilderIO(const ImFontBuilderIO* builderIO);
+    }
+
+    namespace
+    {
+        using namespace FontAtlasInternal;
+
+        // Same heuristic as ImFontAtlas::Build()
+        int TextureWidthForSurface(int totalSurface)
+        {
+            const int surfaceSqrt = (int)std::sqrt((float)totalSurface) + 1;
+            return (surfaceSqrt >= 4096 * 0.7f) ? 4096 : (surfaceSqrt >= 2048 * 0.7f) ? 2048 : (surfaceSqrt >= 1024 * 0.7f) ? 1024 : 512;
+        }
+
+        // A rectangle to be placed in the final atlas: either a glyph, or a custom rect
+        struct PackRect
+        {
+            int Width = 0, Height = 0;
+            int ConfigIdx = -1;      // -1 for custom rects
+            int Idx = 0;             // Glyph index in the config output, or custom rect index
+            int X = 0, Y = 0;        // Position in the final atlas
+        };
+
+        // Simple shelf packer: the rects are sorted by decreasing height (ties are kept in their original order)
+        // Returns the used height, or -1 if a rect does not fit the width
+        int PackRects(std::vector<PackRect>& rects, int texWidth, int padding)
+        {
+            std::vector<size_t> order(rects.size());
+            for (size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(),
+                             [&rects](size_t a, size_t b) { return rects[a].Height > rects[b].Height; });
+
+            int x = 0, y = 0, shelfHeight = 0;
+            for (size_t i: order)
+            {
+                PackRect& rect = rects[i];
+                if (rect.Width + padding > texWidth)
+                    return -1;
+                if (x + rect.Width + padding > texWidth)
+                {
+                    y += shelfHeight;
+                    x = 0;
+                    shelfHeight = 0;
+                }
+                rect.X = x;
+                rect.Y = y;
+                x += rect.Width + padding;
+                shelfHeight = std::max(shelfHeight, rect.Height + padding);
+            }
+            return y + shelfHeight;
+        }
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+        // Rasterizes a config, as ImFontAtlasBuildWithStbTruetype does.
+        // dstGlyphsSet contains the codepoints already provided by the previous configs of the same font.
+        RasterizedConfig RasterizeConfig(const RasterizerConfigInput& input, int padding, std::vector<bool>* dstGlyphsSet)
+        {
+            RasterizedConfig r;
+            const unsigned char* fontData = (const unsigned char*)input.FontData;
+            stbtt_fontinfo fontInfo;
+            const int fontOffset = stbtt_GetFontOffsetForIndex(fontData, input.FontNo);
+            if (fontData == nullptr || fontOffset < 0 || !stbtt_InitFont(&fontInfo, fontData, fontOffset))
+                return r;
+
+            // The requested codepoints, which are available in this font, and not provided by a previous config
+            std::vector<int> codepoints;
+            for (size_t i = 0; i + 1 < input.GlyphRanges.size() && input.GlyphRanges[i] != 0; i += 2)
+            {
+                const unsigned int first = input.GlyphRanges[i];
+                const unsigned int last = std::min((unsigned int)input.GlyphRanges[i + 1], (unsigned int)IM_UNICODE_CODEPOINT_MAX);
+                if (last >= dstGlyphsSet->size())
+                    dstGlyphsSet->resize((size_t)last + 1, false);
+                for (unsigned int codepoint = first; codepoint <= last; ++codepoint)
+                {
+                    if ((*dstGlyphsSet)[codepoint] || !stbtt_FindGlyphIndex(&fontInfo, (int)codepoint))
+                        continue;
+                    (*dstGlyphsSet)[codepoint] = true;
+                    codepoints.push_back((int)codepoint);
+                }
+            }
+            std::sort(codepoints.begin(), codepoints.end());
+
+            // Glyph sizes (the padding and the oversampling are included, as in ImGui)
+            const float scale = (input.SizePixels > 0.0f)
+                ? stbtt_ScaleForPixelHeight(&fontInfo, input.SizePixels * input.RasterizerDensity)
+                : stbtt_ScaleForMappingEmToPixels(&fontInfo, -input.SizePixels * input.RasterizerDensity);
+            std::vector<stbrp_rect> rects(codepoints.size());
+            int totalSurface = 0;
+            for (size_t i = 0; i < codepoints.size(); ++i)
+            {
+                int x0, y0, x1, y1;
+                const int glyphIndex = stbtt_FindGlyphIndex(&fontInfo, codepoints[i]);
+                stbtt_GetGlyphBitmapBoxSubpixel(&fontInfo, glyphIndex, scale * input.OversampleH, scale * input.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+                memset(&rects[i], 0, sizeof(stbrp_rect));
+                rects[i].w = (stbrp_coord)(x1 - x0 + padding + input.OversampleH - 1);
+                rects[i].h = (stbrp_coord)(y1 - y0 + padding + input.OversampleV - 1);
+                totalSurface += rects[i].w * rects[i].h;
+            }
+
+            // Pack & render into a private bitmap
+            std::vector<stbtt_packedchar> packedChars(codepoints.size());
+            if (!codepoints.empty())
+            {
+                const int bitmapHeightMax = 1024 * 32;
+                const int bitmapWidth = TextureWidthForSurface(totalSurface);
+                stbtt_pack_context spc = {};
+                if (!stbtt_PackBegin(&spc, nullptr, bitmapWidth, bitmapHeightMax, 0, padding, nullptr))
+                    return r;
+                stbrp_pack_rects((stbrp_context*)spc.pack_info, rects.data(), (int)rects.size());
+                int bitmapHeight = 0;
+                bool allPacked = true;
+                for (const stbrp_rect& rect: rects)
+                {
+                    allPacked = allPacked && rect.was_packed;
+                    bitmapHeight = std::max(bitmapHeight, (int)(rect.y + rect.h));
+                }
+                if (!allPacked)
+                {
+                    stbtt_PackEnd(&spc);
+                    return r;
+                }
+
+                r.BitmapWidth = bitmapWidth;
+                r.BitmapHeight = bitmapHeight;
+                r.Bitmap.assign((size_t)bitmapWidth * (size_t)bitmapHeight, 0);
+                spc.pixels = r.Bitmap.data();
+                spc.height = bitmapHeight;
+
+                stbtt_pack_range packRange = {};
+                packRange.font_size = input.SizePixels * input.RasterizerDensity;
+                packRange.first_unicode_codepoint_in_range = 0;
+                packRange.array_of_unicode_codepoints = codepoints.data();
+                packRange.num_chars = (int)codepoints.size();
+                packRange.chardata_for_range = packedChars.data();
+                packRange.h_oversample = (unsigned char)input.OversampleH;
+                packRange.v_oversample = (unsigned char)input.OversampleV;
+                stbtt_PackFontRangesRenderIntoRects(&spc, &fontInfo, &packRange, 1, rects.data());
+                stbtt_PackEnd(&spc);
+            }
+
+            // Ascent & descent: as in ImGui, they are computed without the rasterizer density
+            const float fontScale = stbtt_ScaleForPixelHeight(&fontInfo, input.SizePixels);
+            int unscaledAscent, unscaledDescent, unscaledLineGap;
+            stbtt_GetFontVMetrics(&fontInfo, &unscaledAscent, &unscaledDescent, &unscaledLineGap);
+            r.Ascent = std::trunc(unscaledAscent * fontScale + ((unscaledAscent > 0) ? +1.f : -1.f));
+            r.Descent = std::trunc(unscaledDescent * fontScale + ((unscaledDescent > 0) ? +1.f : -1.f));
+
+            // Glyphs (ImFontAtlasBuildMultiplyCalcLookupTable does not allocate: it can be called from any thread)
+            unsigned char multiplyTable[256];
+            if (input.RasterizerMultiply != 1.0f)
+                ImFontAtlasBuildMultiplyCalcLookupTable(multiplyTable, input.RasterizerMultiply);
+            const float invRasterizationScale = 1.0f / input.RasterizerDensity;
+            r.Glyphs.resize(codepoints.size());
+            for (size_t i = 0; i < codepoints.size(); ++i)
+            {
+                const stbtt_packedchar& pc = packedChars[i];
+                RasterizedGlyph& glyph = r.Glyphs[i];
+                glyph.Codepoint = (unsigned int)codepoints[i];
+                glyph.X0 = pc.xoff * invRasterizationScale;
+                glyph.Y0 = pc.yoff * invRasterizationScale;
+                glyph.X1 = pc.xoff2 * invRasterizationScale;
+                glyph.Y1 = pc.yoff2 * invRasterizationScale;
+                glyph.AdvanceX = pc.xadvance * invRasterizationScale;
+                glyph.BitmapX = pc.x0;
+                glyph.BitmapY = pc.y0;
+                glyph.Width = pc.x1 - pc.x0;
+                glyph.Height = pc.y1 - pc.y0;
+                if (input.RasterizerMultiply != 1.0f)
+                {
+                    for (int y = 0; y < glyph.Height; ++y)
+                    {
+                        unsigned char* row = r.Bitmap.data() + (size_t)(glyph.BitmapY + y) * (size_t)r.BitmapWidth + glyph.BitmapX;
+                        for (int x = 0; x < glyph.Width; ++x)
+                            row[x] = multiplyTable[row[x]];
+                    }
+                }
+            }
+            r.Success = true;
+            return r;
+        }
+#endif // #ifdef IMGUI_ENABLE_STB_TRUETYPE
+    } // anonymous namespace
+
+
+    namespace FontAtlasInternal
+    {
+        bool CanRasterizeOffThread(const ImFontBuilderIO* builderIO)
+        {
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+            return builderIO != nullptr && BaseFontBuilderIO(builderIO) == ImFontAtlasGetBuilderForStbTruetype();
+#else
+            (void)builderIO;
+            return false;
+#endif
+        }
+
+
+        std::vector<RasterizerFontGroup> MakeRasterizerFontGroups(const ImFontAtlas* atlas)
+        {
+            std::vector<RasterizerFontGroup> groups;
+            std::vector<const ImFont*> groupFonts;
+            for (int i = 0; i < atlas->ConfigData.Size; ++i)
+            {
+                const ImFontConfig& cfg = atlas->ConfigData[i];
+                size_t groupIdx = std::find(groupFonts.begin(), groupFonts.end(), cfg.DstFont) - groupFonts.begin();
+                if (groupIdx == groupFonts.size())
+                {
+                    groupFonts.push_back(cfg.DstFont);
+                    groups.emplace_back();
+                    groups.back().GlyphPadding = atlas->TexGlyphPadding;
+                }
+
+                RasterizerConfigInput input;
+                input.ConfigIdx = i;
+                input.FontData = cfg.FontData;
+                input.FontDataSize = cfg.FontDataSize;
+                input.FontNo = cfg.FontNo;
+                input.SizePixels = cfg.SizePixels;
+                input.RasterizerDensity = cfg.RasterizerDensity;
+                input.RasterizerMultiply = cfg.RasterizerMultiply;
+                input.OversampleH = cfg.OversampleH;
+                input.OversampleV = cfg.OversampleV;
+                const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : const_cast<ImFontAtlas*>(atlas)->GetGlyphRangesDefault();
+                for (const ImWchar* range = ranges; *range != 0; ++range)
+                    input.GlyphRanges.push_back(*range);
+                input.GlyphRanges.push_back(0);
+                groups[groupIdx].Configs.push_back(std::move(input));
+            }
+            return groups;
+        }
+
+
+        bool RasterizeFontGroup(RasterizerFontGroup* group)
+        {
+            group->Outputs.clear();
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+            std::vector<bool> dstGlyphsSet;
+            for (const RasterizerConfigInput& input: group->Configs)
+            {
+                group->Outputs.push_back(RasterizeConfig(input, group->GlyphPadding, &dstGlyphsSet));
+                if (!group->Outputs.back().Success)
+                    return false;
+            }
+            return true;
+#else
+            return false;
+#endif
+        }
+
+
+        bool AssembleRasterizedAtlas(ImFontAtlas* atlas, const std::vector<RasterizerFontGroup>& groups)
+        {
+            // The output of each config
+            std::vector<const RasterizedConfig*> outputs((size_t)atlas->ConfigData.Size, nullptr);
+            for (const RasterizerFontGroup& group: groups)
+            {
+                if (group.Outputs.size() != group.Configs.size())
+                    return false;
+                for (size_t i = 0; i < group.Configs.size(); ++i)
+                {
+                    int configIdx = group.Configs[i].ConfigIdx;
+                    if (configIdx < 0 || configIdx >= atlas->ConfigData.Size || !group.Outputs[i].Success)
+                        return false;
+                    outputs[(size_t)configIdx] = &group.Outputs[i];
+                }
+            }
+            if (std::find(outputs.begin(), outputs.end(), nullptr) != outputs.end())
+                return false;
+
+            // Registers the default custom rects (mouse cursors, lines)
+            ImFontAtlasBuildInit(atlas);
+
+            const int padding = atlas->TexGlyphPadding;
+            std::vector<PackRect> rects;
+            for (int i = 0; i < atlas->CustomRects.Size; ++i)
+            {
+                PackRect rect;
+                rect.Width = atlas->CustomRects[i].Width;
+                rect.Height = atlas->CustomRects[i].Height;
+                rect.Idx = i;
+                rects.push_back(rect);
+            }
+            // Position of each glyph in the final atlas (index in rects, or -1 for empty glyphs)
+            std::vector<std::vector<int>> glyphRects(outputs.size());
+            for (size_t configIdx = 0; configIdx < outputs.size(); ++configIdx)
+            {
+                const RasterizedConfig& output = *outputs[configIdx];
+                glyphRects[configIdx].assign(output.Glyphs.size(), -1);
+                for (size_t glyphIdx = 0; glyphIdx < output.Glyphs.size(); ++glyphIdx)
+                {
+                    const RasterizedGlyph& glyph = output.Glyphs[glyphIdx];
+                    if (glyph.Width <= 0 || glyph.Height <= 0)
+                        continue;
+                    PackRect rect;
+                    rect.Width = glyph.Width;
+                    rect.Height = glyph.Height;
+                    rect.ConfigIdx = (int)configIdx;
+                    rect.Idx = (int)glyphIdx;
+                    glyphRects[configIdx][glyphIdx] = (int)rects.size();
+                    rects.push_back(rect);
+                }
+            }
+
+            int totalSurface = 0;
+            for (const auto& rect: rects)
+                totalSurface += (rect.Width + padding) * (rect.Height + padding);
+            const int texWidth = atlas->TexDesiredWidth > 0 ? atlas->TexDesiredWidth : TextureWidthForSurface(totalSurface);
+            const int usedHeight = PackRects(rects, texWidth, padding);
+            if (usedHeight < 0)
+                return false;
+            const int texHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (usedHeight + 1) : ImUpperPowerOfTwo(usedHeight);
+
+            atlas->TexID = (ImTextureID)0;
+            atlas->ClearTexData();
+            atlas->TexWidth = texWidth;
+            atlas->TexHeight = texHeight;
+            atlas->TexUvScale = ImVec2(1.0f / (float)texWidth, 1.0f / (float)texHeight);
+            atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)texWidth * (size_t)texHeight);
+            memset(atlas->TexPixelsAlpha8, 0, (size_t)texWidth * (size_t)texHeight);
+
+            // Copy the glyphs bitmaps
+            for (const auto& rect: rects)
+            {
+                if (rect.ConfigIdx < 0)
+                {
+                    atlas->CustomRects[rect.Idx].X = (unsigned short)rect.X;
+                    atlas->CustomRects[rect.Idx].Y = (unsigned short)rect.Y;
+                    continue;
+                }
+                const RasterizedConfig& output = *outputs[(size_t)rect.ConfigIdx];
+                const RasterizedGlyph& glyph = output.Glyphs[(size_t)rect.Idx];
+                for (int row = 0; row < rect.Height; ++row)
+                    memcpy(atlas->TexPixelsAlpha8 + (size_t)(rect.Y + row) * texWidth + rect.X,
+                           output.Bitmap.data() + (size_t)(glyph.BitmapY + row) * output.BitmapWidth + glyph.BitmapX,
+                           (size_t)rect.Width);
+            }
+
+            // Setup the fonts & glyphs, as ImFontAtlasBuildWithStbTruetype does
+            for (int configIdx = 0; configIdx < atlas->ConfigData.Size; ++configIdx)
+            {
+                ImFontConfig& cfg = atlas->ConfigData[configIdx];
+                const RasterizedConfig& output = *outputs[(size_t)configIdx];
+                ImFont* dstFont = cfg.DstFont;
+                ImFontAtlasBuildSetupFont(atlas, dstFont, &cfg, output.Ascent, output.Descent);
+
+                const float fontOffX = cfg.GlyphOffset.x;
+                const float fontOffY = cfg.GlyphOffset.y + IM_ROUND(dstFont->Ascent);
+                for (size_t glyphIdx = 0; glyphIdx < output.Glyphs.size(); ++glyphIdx)
+                {
+                    const RasterizedGlyph& glyph = output.Glyphs[glyphIdx];
+                    int rectIdx = glyphRects[(size_t)configIdx][glyphIdx];
+                    const float x = rectIdx >= 0 ? (float)rects[(size_t)rectIdx].X : 0.f;
+                    const float y = rectIdx >= 0 ? (float)rects[(size_t)rectIdx].Y : 0.f;
+                    dstFont->AddGlyph(&cfg, (ImWchar)glyph.Codepoint,
+                                      glyph.X0 + fontOffX, glyph.Y0 + fontOffY, glyph.X1 + fontOffX, glyph.Y1 + fontOffY,
+                                      x * atlas->TexUvScale.x, y * atlas->TexUvScale.y,
+                                      (x + (float)glyph.Width) * atlas->TexUvScale.x, (y + (float)glyph.Height) * atlas->TexUvScale.y,
+                                      glyph.AdvanceX);
+                }
+            }
+
+            // Renders the default texture data (white pixel, cursors, lines) & builds the lookup tables
+            ImFontAtlasBuildFinish(atlas);
+            return true;
+        }
+    } // namespace FontAtlasInternal
+
+} // namespace ImmApp
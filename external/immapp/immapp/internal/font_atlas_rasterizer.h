@@ -0,0 +1,81 @@
+#pragma once
+#include "imgui.h"
+
+#include <vector>
+
+
+struct ImFontBuilderIO;
+
+
+namespace ImmApp
+{
+    namespace FontAtlasInternal
+    {
+        /////////////////////////////////////////////////////////////////////////////////////////
+        //
+        // Rasterization of the fonts of an atlas, outside of the main thread
+        //
+        // ImFontAtlas::Build() cannot run on a worker thread: every ImGui allocation
+        // (IM_ALLOC) updates the debug counters of the current ImGui context.
+        // Instead, the atlas build is split in three steps:
+        //   - MakeRasterizerFontGroups (main thread) copies the inputs of the atlas (the font data is not copied)
+        //   - RasterizeFontGroup (any thread) rasterizes the glyphs with stb_truetype, into private bitmaps.
+        //     It does not call ImGui, and only allocates with malloc (or std containers).
+        //   - AssembleRasterizedAtlas (main thread) packs the bitmaps into the atlas texture, and sets up the fonts
+        // The result is the same as with the stb_truetype builder of ImGui (except for the glyphs placement in the texture).
+        //
+        /////////////////////////////////////////////////////////////////////////////////////////
+
+        // The inputs of an ImFontConfig
+        struct RasterizerConfigInput
+        {
+            int ConfigIdx = 0;                  // Index in atlas->ConfigData
+            const void* FontData = nullptr;     // Not owned: must stay valid until RasterizeFontGroup returns
+            int FontDataSize = 0;
+            int FontNo = 0;
+            float SizePixels = 0.f;
+            float RasterizerDensity = 1.f;
+            float RasterizerMultiply = 1.f;
+            int OversampleH = 1, OversampleV = 1;
+            std::vector<ImWchar> GlyphRanges;   // Zero terminated
+        };
+
+        struct RasterizedGlyph
+        {
+            unsigned int Codepoint = 0;
+            float X0 = 0.f, Y0 = 0.f, X1 = 0.f, Y1 = 0.f;   // Quad, without the GlyphOffset / ascent offsets
+            float AdvanceX = 0.f;
+            int BitmapX = 0, BitmapY = 0, Width = 0, Height = 0; // Position in RasterizedConfig::Bitmap
+        };
+
+        struct RasterizedConfig
+        {
+            bool Success = false;
+            float Ascent = 0.f, Descent = 0.f;
+            std::vector<RasterizedGlyph> Glyphs;
+            int BitmapWidth = 0, BitmapHeight = 0;
+            std::vector<unsigned char> Bitmap;  // Alpha8
+        };
+
+        // A font, together with the fonts merged into it: the codepoints provided by a config
+        // are skipped in the following configs, so that the configs of a group are rasterized together.
+        struct RasterizerFontGroup
+        {
+            int GlyphPadding = 1;
+            std::vector<RasterizerConfigInput> Configs;    // In the atlas order
+            std::vector<RasterizedConfig> Outputs;         // Filled by RasterizeFontGroup
+        };
+
+        // True if builderIO (or the builder it delegates to) is the stb_truetype builder
+        bool CanRasterizeOffThread(const ImFontBuilderIO* builderIO);
+
+        std::vector<RasterizerFontGroup> MakeRasterizerFontGroups(const ImFontAtlas* atlas);
+
+        // Returns true if all the configs of the group were rasterized
+        bool RasterizeFontGroup(RasterizerFontGroup* group);
+
+        // Returns false if the outputs do not match the atlas configs, or do not fit the texture
+        // (the atlas should then be built by its builder)
+        bool AssembleRasterizedAtlas(ImFontAtlas* atlas, const std::vector<RasterizerFontGroup>& groups);
+    }
+} // namespace ImmApp
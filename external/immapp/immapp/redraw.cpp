@@ -0,0 +1,213 @@
+#include "immapp/redraw.h"
+#include "immapp/clock.h"
+#include "hello_imgui/hello_imgui.h"
+
+#ifdef HELLOIMGUI_USE_GLFW3
+#include <GLFW/glfw3.h>
+#endif
+#ifdef HELLOIMGUI_USE_SDL2
+#include "SDL.h"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define IMMAPP_REDRAW_NO_THREADS
+#endif
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        // Set between PostInit and BeforeExit, i.e. while the platform backend can receive events.
+        // gPlatformMutex guarantees that no event is being posted once the platform is shut down.
+        std::atomic<bool> gPlatformReady { false };
+        std::mutex gPlatformMutex;
+        HelloImGui::PlatformBackendType gPlatformBackendType = HelloImGui::PlatformBackendType::FirstAvailable;
+
+        // Wakes up the event wait of the platform backend (thread safe)
+        void PostEmptyEvent()
+        {
+            std::lock_guard<std::mutex> lock(gPlatformMutex);
+            if (!gPlatformReady.load(std::memory_order_acquire))
+                return;
+
+            using HelloImGui::PlatformBackendType;
+            // When both backends are compiled, FirstAvailable selects Glfw
+#ifdef HELLOIMGUI_USE_GLFW3
+            if (gPlatformBackendType == PlatformBackendType::Glfw || gPlatformBackendType == PlatformBackendType::FirstAvailable)
+            {
+                glfwPostEmptyEvent();
+                return;
+            }
+#endif
+#ifdef HELLOIMGUI_USE_SDL2
+            if (gPlatformBackendType == PlatformBackendType::Sdl || gPlatformBackendType == PlatformBackendType::FirstAvailable)
+            {
+                SDL_Event event;
+                SDL_zero(event);
+                event.type = SDL_USEREVENT;
+                SDL_PushEvent(&event);
+                return;
+            }
+#endif
+        }
+
+
+#ifndef IMMAPP_REDRAW_NO_THREADS
+        // A worker thread that sleeps until the earliest pending deadline, then wakes up the application.
+        // It is started on demand, only between Enable() and Stop(): a request which races with
+        // the shutdown cannot restart it.
+        class RedrawScheduler
+        {
+        public:
+            void Enable()
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mIsEnabled = true;
+            }
+
+            void Schedule(double timeSeconds)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    if (!mIsEnabled)
+                        return;
+                    if (!mThread.joinable())
+                    {
+                        mShallStop = false;
+                        mThread = std::thread([this]() { ThreadLoop(); });
+                    }
+                    mDeadlines.push(timeSeconds);
+                }
+                mCondition.notify_one();
+            }
+
+            void Stop()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mIsEnabled = false;
+                    if (!mThread.joinable())
+                        return;
+                    mShallStop = true;
+                }
+                mCondition.notify_one();
+                mThread.join();
+
+                std::lock_guard<std::mutex> lock(mMutex);
+                mDeadlines = DeadlineQueue();
+            }
+
+            ~RedrawScheduler() { Stop(); }
+
+        private:
+            void ThreadLoop()
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                while (!mShallStop)
+                {
+                    if (mDeadlines.empty())
+                    {
+                        mCondition.wait(lock);
+                        continue;
+                    }
+
+                    double now = ClockSeconds();
+                    double nextDeadline = mDeadlines.top();
+                    if (nextDeadline > now)
+                    {
+                        // Wait until the deadline, or until an earlier deadline is scheduled
+                        mCondition.wait_for(lock, std::chrono::duration<double>(nextDeadline - now));
+                        continue;
+                    }
+
+                    // Pop all the expired deadlines, and post a single wake up
+                    while (!mDeadlines.empty() && mDeadlines.top() <= now)
+                        mDeadlines.pop();
+                    lock.unlock();
+                    PostEmptyEvent();
+                    lock.lock();
+                }
+            }
+
+            using DeadlineQueue = std::priority_queue<double, std::vector<double>, std::greater<double>>;
+
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            DeadlineQueue mDeadlines;
+            std::thread mThread;
+            bool mShallStop = false;
+            bool mIsEnabled = false;
+        };
+
+        RedrawScheduler gRedrawScheduler;
+#endif // #ifndef IMMAPP_REDRAW_NO_THREADS
+    } // anonymous namespace
+
+
+    void RequestRedraw()
+    {
+        PostEmptyEvent();
+    }
+
+
+    void RequestRedrawAt(double timeSeconds)
+    {
+        if (!gPlatformReady.load(std::memory_order_acquire))
+            return;
+        if (timeSeconds <= ClockSeconds())
+        {
+            PostEmptyEvent();
+            return;
+        }
+#ifndef IMMAPP_REDRAW_NO_THREADS
+        gRedrawScheduler.Schedule(timeSeconds);
+#else
+        // Without threads (emscripten), the browser drives the main loop, and
+        // a deferred wake up cannot be scheduled: the request is ignored.
+#endif
+    }
+
+
+    void RequestRedrawIn(double delaySeconds)
+    {
+        RequestRedrawAt(ClockSeconds() + delaySeconds);
+    }
+
+
+    namespace RedrawInternal
+    {
+        // Called in PostInit: the platform backend is ready to receive events
+        void OnPlatformReady()
+        {
+            std::lock_guard<std::mutex> lock(gPlatformMutex);
+            gPlatformBackendType = HelloImGui::GetRunnerParams()->platformBackendType;
+            gPlatformReady.store(true, std::memory_order_release);
+#ifndef IMMAPP_REDRAW_NO_THREADS
+            gRedrawScheduler.Enable();
+#endif
+        }
+
+        // Called in BeforeExit: stop the scheduler before the platform backend is shut down
+        void OnPlatformShutdown()
+        {
+            {
+                std::lock_guard<std::mutex> lock(gPlatformMutex);
+                gPlatformReady.store(false, std::memory_order_release);
+            }
+#ifndef IMMAPP_REDRAW_NO_THREADS
+            gRedrawScheduler.Stop();
+#endif
+        }
+    } // namespace RedrawInternal
+
+} // namespace ImmApp
@@ -0,0 +1,30 @@
+#pragma once
+
+
+namespace ImmApp
+{
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Redraw requests: wake up an idling application
+    //
+    // When idling (see HelloImGui::FpsIdling), the application waits for user events,
+    // and only renders fpsIdle frames per second. Instead of raising fpsIdle, widgets
+    // and worker threads can request exactly the frames they need:
+    //     - RequestRedraw(): render a new frame as soon as possible
+    //     - RequestRedrawAt(t): render a new frame at time t (as given by ImmApp::ClockSeconds())
+    // With this, fpsIdle can be set to a low value (e.g. 1), while keeping live data up to date.
+    //
+    // These functions can be called from any thread. They do nothing if no application is running.
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+
+    // RequestRedraw: wakes up the application, so that a new frame is rendered as soon as possible.
+    void RequestRedraw();
+
+    // RequestRedrawAt: requests that a new frame be rendered at the given time
+    // (timeSeconds is given in the same unit/origin as ImmApp::ClockSeconds()).
+    void RequestRedrawAt(double timeSeconds);
+
+    // RequestRedrawIn: requests that a new frame be rendered after delaySeconds
+    void RequestRedrawIn(double delaySeconds);
+} // namespace ImmApp
@@ -18,6 +18,7 @@
 #endif
 
 #include <chrono>
+#include <memory>
 #include <cassert>
 #include <filesystem>
 
@@ -25,6 +26,15 @@
 // Private API used by ImGuiTexInspect (not mentioned in headers!)
 namespace HelloImGui { std::string GlslVersion(); }
 
+// Private API, implemented in frame_timings.cpp
+namespace ImmApp { namespace FrameTimingsInternal { void InstallFrameTimingsCallbacks(HelloImGui::RunnerParams& runnerParams); } }
+// Private API, implemented in redraw.cpp
+namespace ImmApp { namespace RedrawInternal { void OnPlatformReady(); void OnPlatformShutdown(); } }
+// Private API, implemented in startup_timeline.cpp
+namespace ImmApp { namespace StartupTimelineInternal { void OnRunStart(); void InstallStartupTimelineCallbacks(HelloImGui::RunnerParams& runnerParams); } }
+// Private API, implemented in font_atlas_async_rebuild.cpp
+namespace ImmApp { namespace FontAtlasAsyncRebuildInternal { void OnPreNewFrame(); void OnExit(); } }
+
 
 namespace ImmApp
 {
@@ -34,6 +44,7 @@ namespace ImmApp
 #ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
         std::optional<ax::NodeEditor::EditorContext *> _NodeEditorContext;
         ax::NodeEditor::Config _NodeEditorConfig;
+        bool _NodeEditorLazyInit = false; // if true, _NodeEditorContext is created by DefaultNodeEditorContext()
 #endif
 
 #ifdef IMGUI_BUNDLE_WITH_TEXT_INSPECT
@@ -46,6 +57,7 @@ namespace ImmApp
 
     void Run(HelloImGui::RunnerParams& runnerParams, const AddOnsParams& addOnsParams_)
     {
+        StartupTimelineInternal::OnRunStart();
         AddOnsParams addOnsParams = addOnsParams_;
 
         // create implot context if required
@@ -66,8 +78,13 @@ namespace ImmApp
             if (gImmAppContext._NodeEditorConfig.SettingsFile == "NodeEditor.json")
                 gImmAppContext._NodeEditorConfig.SettingsFile = NodeEditorSettingsLocation(runnerParams);
 
-            gImmAppContext._NodeEditorContext = ax::NodeEditor::CreateEditor(&gImmAppContext._NodeEditorConfig);
-            ax::NodeEditor::SetCurrentEditor(gImmAppContext._NodeEditorContext.value());
+            if (addOnsParams.withLazyInit)
+                gImmAppContext._NodeEditorLazyInit = true;
+            else
+            {
+                gImmAppContext._NodeEditorContext = ax::NodeEditor::CreateEditor(&gImmAppContext._NodeEditorConfig);
+                ax::NodeEditor::SetCurrentEditor(gImmAppContext._NodeEditorContext.value());
+            }
         }
 #endif
 
@@ -78,9 +95,42 @@ namespace ImmApp
                 addOnsParams.withMarkdownOptions = ImGuiMd::MarkdownOptions();
             ImGuiMd::InitializeMarkdown(addOnsParams.withMarkdownOptions.value());
 
-            runnerParams.callbacks.LoadAdditionalFonts = HelloImGui::SequenceFunctions(
-                runnerParams.callbacks.LoadAdditionalFonts,
-                ImGuiMd::GetFontLoaderFunction());
+            if (addOnsParams.withLazyInit)
+                ImGuiMd::EnableLazyFontLoading();
+            else
+                runnerParams.callbacks.LoadAdditionalFonts = HelloImGui::SequenceFunctions(
+                    runnerParams.callbacks.LoadAdditionalFonts,
+                    ImGuiMd::GetFontLoaderFunction());
+        }
+
+        // Install the parallel font builder (the fonts are loaded and built after SetupImGuiConfig)
+        if (addOnsParams.withParallelFontBuild)
+            runnerParams.callbacks.SetupImGuiConfig = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.SetupImGuiConfig,
+                []() { InstallParallelFontBuilder(); });
+
+        // Install the font atlas cache
+        // (after the parallel font builder, which will then be used on cache misses)
+        if (addOnsParams.withFontAtlasCache)
+        {
+            std::string fontAtlasCacheFolder = FontAtlasCacheFolder(runnerParams);
+            runnerParams.callbacks.SetupImGuiConfig = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.SetupImGuiConfig,
+                [fontAtlasCacheFolder]() { InstallFontAtlasCache(fontAtlasCacheFolder); });
+        }
+
+        // Install the async font rebuild (after the other font builders, which will be used for its synchronous builds)
+        if (addOnsParams.withAsyncFontRebuild)
+        {
+            runnerParams.callbacks.SetupImGuiConfig = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.SetupImGuiConfig,
+                []() { InstallAsyncFontRebuild(); });
+            runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+                FontAtlasAsyncRebuildInternal::OnPreNewFrame,
+                runnerParams.callbacks.PreNewFrame);
+            runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.BeforeExit,
+                FontAtlasAsyncRebuildInternal::OnExit);
         }
 
 #ifdef IMGUI_BUNDLE_WITH_IMFILEDIALOG
@@ -129,6 +179,20 @@ namespace ImmApp
         }
 #endif
 
+        // Enable RequestRedraw() while the platform backend is alive
+        runnerParams.callbacks.PostInit = HelloImGui::SequenceFunctions(
+            runnerParams.callbacks.PostInit,
+            RedrawInternal::OnPlatformReady);
+        runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+            RedrawInternal::OnPlatformShutdown,
+            runnerParams.callbacks.BeforeExit);
+
+        // Destroy the markdown renderer (and the textures of its images), before OpenGl is uninitialized
+        if (addOnsParams.withMarkdown || addOnsParams.withMarkdownOptions.has_value())
+            runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.BeforeExit,
+                ImGuiMd::DeInitializeMarkdown);
+
 #ifdef IMGUI_BUNDLE_WITH_IMMVISION
         // Clear ImmVision cache, before OpenGl is uninitialized
         runnerParams.callbacks.BeforeExit = HelloImGui::SequenceFunctions(
@@ -136,6 +200,11 @@ namespace ImmApp
             ImmVision::ClearTextureCache);
 #endif
 
+        // Wrap the callbacks with timers (this should be done last, so that all the callbacks are timed)
+        if (addOnsParams.withFrameTimings)
+            FrameTimingsInternal::InstallFrameTimingsCallbacks(runnerParams);
+
+        StartupTimelineInternal::InstallStartupTimelineCallbacks(runnerParams);
 
         HelloImGui::Run(runnerParams);
 
@@ -147,15 +216,14 @@ namespace ImmApp
 #ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
         if (addOnsParams.withNodeEditor)
         {
-            assert(gImmAppContext._NodeEditorContext.has_value());
-            ax::NodeEditor::DestroyEditor(*gImmAppContext._NodeEditorContext);
+            // (with lazy init, the context may never have been created)
+            assert(gImmAppContext._NodeEditorContext.has_value() || gImmAppContext._NodeEditorLazyInit);
+            if (gImmAppContext._NodeEditorContext.has_value())
+                ax::NodeEditor::DestroyEditor(*gImmAppContext._NodeEditorContext);
             gImmAppContext._NodeEditorContext = std::nullopt;
+            gImmAppContext._NodeEditorLazyInit = false;
         }
 #endif
-
-        if (addOnsParams.withMarkdown || addOnsParams.withMarkdownOptions.has_value())
-            ImGuiMd::DeInitializeMarkdown();
-
     }
 
     void Run(const HelloImGui::SimpleRunnerParams& simpleParams, const AddOnsParams& addOnsParams)
@@ -247,6 +315,60 @@ namespace ImmApp
         Run(simpleRunnerParams, addOnsParams);
     }
 
+
+    void RunWithNullBackend(
+        HelloImGui::RunnerParams& runnerParams,
+        const AddOnsParams& addOnsParams,
+        const NullBackendParams& nullBackendParams)
+    {
+        // The params are restored after the run, so that they can be reused for another run
+        // (otherwise, the frame counter of the previous run would exit after the first frame)
+        auto platformBackendType = runnerParams.platformBackendType;
+        auto rendererBackendType = runnerParams.rendererBackendType;
+        bool enableIdling = runnerParams.fpsIdling.enableIdling;
+        bool appShallExit = runnerParams.appShallExit;
+        auto preNewFrame = runnerParams.callbacks.PreNewFrame;
+        auto beforeImGuiRender = runnerParams.callbacks.BeforeImGuiRender;
+
+        runnerParams.platformBackendType = HelloImGui::PlatformBackendType::Null;
+        runnerParams.rendererBackendType = HelloImGui::RendererBackendType::Null;
+
+        // No event will ever wake us up: never idle
+        runnerParams.fpsIdling.enableIdling = false;
+
+        // Drive ImGui at a fixed time step (PreNewFrame is called before ImGui::NewFrame)
+        float fixedDeltaTime = nullBackendParams.fixedDeltaTime;
+        IM_ASSERT(fixedDeltaTime > 0.f);
+        runnerParams.callbacks.PreNewFrame = HelloImGui::SequenceFunctions(
+            [fixedDeltaTime]() { ImGui::GetIO().DeltaTime = fixedDeltaTime; },
+            runnerParams.callbacks.PreNewFrame);
+
+        // Exit after nbFrames
+        if (nullBackendParams.nbFrames > 0)
+        {
+            int nbFrames = nullBackendParams.nbFrames;
+            auto nbRenderedFrames = std::make_shared<int>(0);
+            runnerParams.callbacks.BeforeImGuiRender = HelloImGui::SequenceFunctions(
+                runnerParams.callbacks.BeforeImGuiRender,
+                [nbFrames, nbRenderedFrames]()
+                {
+                    *nbRenderedFrames += 1;
+                    if (*nbRenderedFrames >= nbFrames)
+                        HelloImGui::GetRunnerParams()->appShallExit = true;
+                });
+        }
+
+        Run(runnerParams, addOnsParams);
+
+        runnerParams.platformBackendType = platformBackendType;
+        runnerParams.rendererBackendType = rendererBackendType;
+        runnerParams.fpsIdling.enableIdling = enableIdling;
+        runnerParams.appShallExit = appShallExit;
+        runnerParams.callbacks.PreNewFrame = preNewFrame;
+        runnerParams.callbacks.BeforeImGuiRender = beforeImGuiRender;
+    }
+
+
     float EmSize()
     {
         return HelloImGui::EmSize();
@@ -278,6 +400,11 @@ namespace ImmApp
 #ifdef IMGUI_BUNDLE_WITH_IMGUI_NODE_EDITOR
     ax::NodeEditor::EditorContext* DefaultNodeEditorContext()
     {
+        if (!gImmAppContext._NodeEditorContext.has_value() && gImmAppContext._NodeEditorLazyInit)
+        {
+            gImmAppContext._NodeEditorContext = ax::NodeEditor::CreateEditor(&gImmAppContext._NodeEditorConfig);
+            ax::NodeEditor::SetCurrentEditor(gImmAppContext._NodeEditorContext.value());
+        }
         if (!gImmAppContext._NodeEditorContext.has_value())
             throw std::runtime_error("No current node editor context\n"
                                      "    Did you set with_node_editor_config when calling ImmApp::Run()?");
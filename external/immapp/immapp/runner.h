@@ -49,6 +49,32 @@ namespace ImmApp
 
         // You can tweak MarkdownOptions (but this is optional)
         std::optional<ImGuiMd::MarkdownOptions> withMarkdownOptions = std::nullopt;
+
+        // Set withFrameTimings=true to record the time spent in each phase of the frames
+        // (see frame_timings.h: GetFrameTimingsStats(), ShowFrameTimingsWindow())
+        bool withFrameTimings = false;
+
+        // Set withLazyInit=true to initialize the addons on first use, instead of at startup:
+        //   - the markdown fonts are loaded at the next frame boundary after the first call to ImGuiMd::Render()
+        //     (nothing is displayed during that frame)
+        //   - the node editor context is created by the first call to DefaultNodeEditorContext()
+        //     (call it before using ax::NodeEditor)
+        // This reduces the startup time of apps which do not always use these addons.
+        // (ImPlot and ImGuiTexInspect contexts are cheap to create, and are still created at startup)
+        bool withLazyInit = false;
+
+        // Set withFontAtlasCache=true to save the baked font atlas to disk, and reload it at the next launches
+        // instead of rasterizing the fonts again (see font_atlas_cache.h)
+        bool withFontAtlasCache = false;
+
+        // Set withParallelFontBuild=true to rasterize the independent fonts on several threads
+        // when the font atlas is built (see font_atlas_parallel_build.h)
+        bool withParallelFontBuild = false;
+
+        // Set withAsyncFontRebuild=true to rebuild the font atlas on a worker thread when the fonts
+        // are reloaded after startup (e.g. after a DPI change), instead of freezing the UI
+        // (see font_atlas_async_rebuild.h)
+        bool withAsyncFontRebuild = false;
     };
 
 
@@ -123,6 +149,33 @@ namespace ImmApp
     );
 
 
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Headless runs, with HelloImGui's Null backend (no window, no GPU)
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+    struct NullBackendParams
+    {
+        // Number of frames to render before exiting
+        // (if 0, the app will run until runnerParams.appShallExit is set to true)
+        int nbFrames = 60;
+
+        // Fixed time step (in seconds) given to ImGui at each frame
+        float fixedDeltaTime = 1.f / 60.f;
+    };
+
+    // RunWithNullBackend: runs an application with the Null platform and renderer backends.
+    // NewFrame/Render are called at each frame, and the resulting ImDrawData is discarded.
+    // All the RunnerCallbacks are called, and the addons are initialized as with Run().
+    // This is useful to measure the CPU cost of your gui functions, on machines without display or GPU
+    // (e.g. CI servers).
+    // The backends, idling and callbacks of runnerParams are restored after the run: they can be reused for another run.
+    void RunWithNullBackend(
+        HelloImGui::RunnerParams& runnerParams,
+        const AddOnsParams& addOnsParams = AddOnsParams(),
+        const NullBackendParams& nullBackendParams = NullBackendParams());
+
+
     /////////////////////////////////////////////////////////////////////////////////////////
     //
     // Dpi aware utilities (which call the same utilities from HelloImGui)
@@ -0,0 +1,364 @@
+#include "immapp/snippet_colorizer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define IMMAPP_SNIPPET_COLORIZER_NO_THREADS
+#endif
+
+
+namespace Snippets
+{
+    namespace
+    {
+        constexpr int kChunkNbLines = 2048;
+
+        bool IsIdentifierStart(char c) { return std::isalpha((unsigned char)c) || c == '_'; }
+        bool IsIdentifierChar(char c) { return std::isalnum((unsigned char)c) || c == '_'; }
+
+        bool StartsWith(const char* s, const char* end, const std::string& prefix)
+        {
+            return !prefix.empty() && (size_t)(end - s) >= prefix.size() && memcmp(s, prefix.data(), prefix.size()) == 0;
+        }
+
+        // Returns end if not found
+        const char* FindSubstring(const char* s, const char* end, const std::string& needle)
+        {
+            if (needle.empty())
+                return end;
+            return std::search(s, end, needle.begin(), needle.end());
+        }
+    }
+
+
+    namespace
+    {
+        // At most kMaxPendingChunks chunks of the code are copied for the worker
+        constexpr size_t kMaxPendingChunks = 4;
+    }
+
+
+    SnippetColorizer::SnippetColorizer(
+        const std::vector<size_t>& lineOffsets, size_t codeSize, const TextEditor::LanguageDefinition& languageDefinition)
+        : mLineOffsets(lineOffsets), mCodeSize(codeSize), mLanguageDefinition(languageDefinition)
+    {
+        mChunks.resize((mLineOffsets.size() + kChunkNbLines - 1) / kChunkNbLines);
+#ifndef IMMAPP_SNIPPET_COLORIZER_NO_THREADS
+        mWorker = std::thread([this]() {
+            while (true)
+            {
+                PendingChunk pendingChunk;
+                {
+                    std::unique_lock<std::mutex> lock(mMutex);
+                    mCondition.wait(lock, [this]() { return mCancelled.load() || !mPendingChunks.empty(); });
+                    if (mCancelled.load())
+                        return;
+                    pendingChunk = std::move(mPendingChunks.front());
+                    mPendingChunks.pop_front();
+                }
+                ColorizeChunk(pendingChunk);
+                mPendingSizeBytes -= pendingChunk.Text.size();
+                pendingChunk.Text = std::string();
+                pendingChunk.LineStarts = std::vector<uint32_t>();
+
+                std::lock_guard<std::mutex> lock(mMutex);
+                mColorizedChunks.push_back(std::move(pendingChunk));
+            }
+        });
+#endif
+    }
+
+    SnippetColorizer::~SnippetColorizer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCancelled = true;
+        }
+        mCondition.notify_all();
+        if (mWorker.joinable())
+            mWorker.join();
+    }
+
+    int SnippetColorizer::GetNbColorizedLines() const
+    {
+        return mNbColorizedLines;
+    }
+
+    void SnippetColorizer::GetLineSpans(int line, const ColorSpan** spansBegin, const ColorSpan** spansEnd) const
+    {
+        const Chunk& chunk = mChunks[(size_t)(line / kChunkNbLines)];
+        int lineInChunk = line % kChunkNbLines;
+        *spansBegin = chunk.Spans.data() + chunk.LineFirstSpan[(size_t)lineInChunk];
+        *spansEnd = chunk.Spans.data() + chunk.LineFirstSpan[(size_t)lineInChunk + 1];
+    }
+
+    size_t SnippetColorizer::ChunkFirstLine(int chunkIdx) const
+    {
+        return (size_t)chunkIdx * kChunkNbLines;
+    }
+
+    // Offset of the end of the chunk in the code (i.e. the start of the next chunk)
+    size_t SnippetColorizer::ChunkEndOffset(int chunkIdx) const
+    {
+        size_t endLine = ChunkFirstLine(chunkIdx + 1);
+        return endLine < mLineOffsets.size() ? mLineOffsets[endLine] : mCodeSize;
+    }
+
+    int SnippetColorizer::NbLinesInChunk(int chunkIdx) const
+    {
+        return (int)(std::min(ChunkFirstLine(chunkIdx + 1), mLineOffsets.size()) - ChunkFirstLine(chunkIdx));
+    }
+
+    SnippetColorizer::PendingChunk SnippetColorizer::MakePendingChunk(int chunkIdx, const std::string& code) const
+    {
+        PendingChunk r;
+        r.ChunkIdx = chunkIdx;
+        size_t firstLine = ChunkFirstLine(chunkIdx);
+        size_t begin = mLineOffsets[firstLine];
+        size_t end = ChunkEndOffset(chunkIdx);
+        r.Text.assign(code.data() + begin, end - begin);
+        r.Result.NbLines = NbLinesInChunk(chunkIdx);
+        r.Result.EndOffset = end;
+        r.LineStarts.reserve((size_t)r.Result.NbLines);
+        for (size_t line = firstLine; line < firstLine + (size_t)r.Result.NbLines; ++line)
+            r.LineStarts.push_back((uint32_t)(mLineOffsets[line] - begin));
+        return r;
+    }
+
+    // The colorized lines are the lines of the leading chunks which were colorized with their current content
+    // (the last line of a chunk which grew since its colorization is not counted)
+    void SnippetColorizer::UpdateNbColorizedLines()
+    {
+        mNbColorizedLines = 0;
+        for (int chunkIdx = 0; chunkIdx < (int)mChunks.size(); ++chunkIdx)
+        {
+            const Chunk& chunk = mChunks[(size_t)chunkIdx];
+            if (chunk.NbLines == NbLinesInChunk(chunkIdx) && chunk.EndOffset == ChunkEndOffset(chunkIdx))
+                mNbColorizedLines += chunk.NbLines;
+            else
+            {
+                mNbColorizedLines += std::max(chunk.NbLines - 1, 0);
+                break;
+            }
+        }
+    }
+
+    void SnippetColorizer::InstallChunk(PendingChunk& pendingChunk)
+    {
+        Chunk& chunk = mChunks[(size_t)pendingChunk.ChunkIdx];
+        // A chunk queued before the code grew may be colorized after a more recent version of it
+        if (pendingChunk.Result.EndOffset < chunk.EndOffset)
+            return;
+        auto chunkSizeBytes = [](const Chunk& c) {
+            return c.Spans.capacity() * sizeof(ColorSpan) + c.LineFirstSpan.capacity() * sizeof(uint32_t);
+        };
+        mColorsSizeBytes -= chunkSizeBytes(chunk);
+        chunk = std::move(pendingChunk.Result);
+        mColorsSizeBytes += chunkSizeBytes(chunk);
+    }
+
+    void SnippetColorizer::Step(const std::string& code)
+    {
+        if (code.size() != mCodeSize)
+            return;
+#ifdef IMMAPP_SNIPPET_COLORIZER_NO_THREADS
+        if (mNextChunkToQueue < (int)mChunks.size())
+        {
+            PendingChunk pendingChunk = MakePendingChunk(mNextChunkToQueue, code);
+            ++mNextChunkToQueue;
+            ColorizeChunk(pendingChunk);
+            InstallChunk(pendingChunk);
+            UpdateNbColorizedLines();
+        }
+#else
+        std::deque<PendingChunk> colorizedChunks;
+        size_t nbPendingChunks;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            colorizedChunks.swap(mColorizedChunks);
+            nbPendingChunks = mPendingChunks.size();
+        }
+
+        // The chunks are copied outside of the lock, so that the worker is not blocked
+        std::vector<PendingChunk> newChunks;
+        while (mNextChunkToQueue < (int)mChunks.size() && nbPendingChunks + newChunks.size() < kMaxPendingChunks)
+        {
+            newChunks.push_back(MakePendingChunk(mNextChunkToQueue, code));
+            mPendingSizeBytes += newChunks.back().Text.size();
+            ++mNextChunkToQueue;
+        }
+        if (!newChunks.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                for (auto& pendingChunk: newChunks)
+                    mPendingChunks.push_back(std::move(pendingChunk));
+            }
+            mCondition.notify_one();
+        }
+
+        for (auto& pendingChunk: colorizedChunks)
+            InstallChunk(pendingChunk);
+        if (!colorizedChunks.empty())
+            UpdateNbColorizedLines();
+#endif
+    }
+
+    void SnippetColorizer::Extend(size_t codeSize)
+    {
+        int oldNbChunks = (int)mChunks.size();
+        mCodeSize = codeSize;
+        mChunks.resize((mLineOffsets.size() + kChunkNbLines - 1) / kChunkNbLines);
+        // The previous last chunk may have grown: it is colorized again
+        if (oldNbChunks > 0)
+            mNextChunkToQueue = std::min(mNextChunkToQueue, oldNbChunks - 1);
+        UpdateNbColorizedLines();
+    }
+
+    size_t SnippetColorizer::SizeBytes() const
+    {
+        return mChunks.capacity() * sizeof(Chunk) + mColorsSizeBytes + mPendingSizeBytes.load();
+    }
+
+    // Colorizes a copy of the code of a chunk (the chunks are colorized in order, except for a chunk which grew,
+    // which is colorized again after the previous ones)
+    void SnippetColorizer::ColorizeChunk(PendingChunk& pendingChunk)
+    {
+        size_t chunkIdx = (size_t)pendingChunk.ChunkIdx;
+        if (mChunkEndsInBlockComment.size() <= chunkIdx)
+            mChunkEndsInBlockComment.resize(chunkIdx + 1, 0);
+        mInBlockComment = chunkIdx > 0 && mChunkEndsInBlockComment[chunkIdx - 1] != 0;
+
+        Chunk& chunk = pendingChunk.Result;
+        const char* text = pendingChunk.Text.data();
+        const char* textEnd = text + pendingChunk.Text.size();
+        const auto& lineStarts = pendingChunk.LineStarts;
+        for (size_t i = 0; i < lineStarts.size(); ++i)
+        {
+            const char* lineBegin = text + lineStarts[i];
+            const char* lineEnd = (i + 1 < lineStarts.size()) ? text + lineStarts[i + 1] - 1 : textEnd;
+            // The last line of a chunk which is not the last one ends with the newline
+            if (i + 1 == lineStarts.size() && lineEnd > lineBegin && lineEnd[-1] == '\n')
+                --lineEnd;
+            chunk.LineFirstSpan.push_back((uint32_t)chunk.Spans.size());
+            ColorizeLine(lineBegin, lineEnd, chunk.Spans);
+        }
+        chunk.LineFirstSpan.push_back((uint32_t)chunk.Spans.size());
+        chunk.Spans.shrink_to_fit();
+        chunk.LineFirstSpan.shrink_to_fit();
+
+        mChunkEndsInBlockComment[chunkIdx] = mInBlockComment ? 1 : 0;
+    }
+
+    // A simplified version of TextEditor colorization: no regexes, a single pass over the line.
+    // The block comment state is carried from one line to the next.
+    void SnippetColorizer::ColorizeLine(const char* lineBegin, const char* lineEnd, std::vector<ColorSpan>& spans)
+    {
+        const auto& lang = mLanguageDefinition;
+        size_t lineFirstSpan = spans.size();
+        auto addSpan = [&](const char* b, const char* e, TextEditor::PaletteIndex colorIndex) {
+            uint32_t start = (uint32_t)(b - lineBegin), end = (uint32_t)(e - lineBegin);
+            if (start == end)
+                return;
+            // Merge with the previous span of this line if it is adjacent and of the same color
+            if (spans.size() > lineFirstSpan && spans.back().ColorIndex == colorIndex && spans.back().End == start)
+                spans.back().End = end;
+            else
+                spans.push_back({ start, end, colorIndex });
+        };
+
+        const char* p = lineBegin;
+        const char* firstNonSpace = lineBegin;
+        while (firstNonSpace < lineEnd && std::isspace((unsigned char)*firstNonSpace))
+            ++firstNonSpace;
+
+        while (p < lineEnd)
+        {
+            if (mInBlockComment)
+            {
+                const char* commentEnd = FindSubstring(p, lineEnd, lang.mCommentEnd);
+                const char* spanEnd = (commentEnd == lineEnd) ? lineEnd : commentEnd + lang.mCommentEnd.size();
+                if (commentEnd != lineEnd)
+                    mInBlockComment = false;
+                addSpan(p, spanEnd, TextEditor::PaletteIndex::MultiLineComment);
+                p = spanEnd;
+                continue;
+            }
+
+            char c = *p;
+            if (std::isspace((unsigned char)c))
+            {
+                ++p;
+                continue;
+            }
+            if (StartsWith(p, lineEnd, lang.mSingleLineComment))
+            {
+                addSpan(p, lineEnd, TextEditor::PaletteIndex::Comment);
+                break;
+            }
+            if (StartsWith(p, lineEnd, lang.mCommentStart))
+            {
+                mInBlockComment = true;
+                const char* contentBegin = p + lang.mCommentStart.size();
+                const char* commentEnd = FindSubstring(contentBegin, lineEnd, lang.mCommentEnd);
+                const char* spanEnd = (commentEnd == lineEnd) ? lineEnd : commentEnd + lang.mCommentEnd.size();
+                if (commentEnd != lineEnd)
+                    mInBlockComment = false;
+                addSpan(p, spanEnd, TextEditor::PaletteIndex::MultiLineComment);
+                p = spanEnd;
+                continue;
+            }
+            if (p == firstNonSpace && c == lang.mPreprocChar)
+            {
+                addSpan(p, lineEnd, TextEditor::PaletteIndex::Preprocessor);
+                break;
+            }
+            if (c == '"' || c == '\'')
+            {
+                const char* q = p + 1;
+                while (q < lineEnd && *q != c)
+                    q += (*q == '\\' && q + 1 < lineEnd) ? 2 : 1;
+                if (q < lineEnd)
+                    ++q;
+                addSpan(p, q, c == '"' ? TextEditor::PaletteIndex::String : TextEditor::PaletteIndex::CharLiteral);
+                p = q;
+                continue;
+            }
+            if (std::isdigit((unsigned char)c) || (c == '.' && p + 1 < lineEnd && std::isdigit((unsigned char)p[1])))
+            {
+                const char* q = p + 1;
+                while (q < lineEnd && (IsIdentifierChar(*q) || *q == '.' || *q == '\''))
+                    ++q;
+                addSpan(p, q, TextEditor::PaletteIndex::Number);
+                p = q;
+                continue;
+            }
+            if (IsIdentifierStart(c))
+            {
+                const char* q = p + 1;
+                while (q < lineEnd && IsIdentifierChar(*q))
+                    ++q;
+                mIdentifierBuffer.assign(p, q);
+                if (!lang.mCaseSensitive)
+                    std::transform(mIdentifierBuffer.begin(), mIdentifierBuffer.end(), mIdentifierBuffer.begin(), ::toupper);
+                TextEditor::PaletteIndex colorIndex = TextEditor::PaletteIndex::Identifier;
+                if (lang.mKeywords.count(mIdentifierBuffer) > 0)
+                    colorIndex = TextEditor::PaletteIndex::Keyword;
+                else if (lang.mIdentifiers.count(mIdentifierBuffer) > 0)
+                    colorIndex = TextEditor::PaletteIndex::KnownIdentifier;
+                addSpan(p, q, colorIndex);
+                p = q;
+                continue;
+            }
+            if (std::ispunct((unsigned char)c))
+            {
+                addSpan(p, p + 1, TextEditor::PaletteIndex::Punctuation);
+                ++p;
+                continue;
+            }
+            ++p; // utf8 continuation bytes, control chars: default color
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "ImGuiColorTextEdit/TextEditor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Snippets
+{
+    // Private API, used by snippets.cpp (virtualized snippets)
+    //
+    // SnippetColorizer computes the syntax colors of a (possibly very large) code on a worker thread,
+    // by chunks of lines, using the keywords, identifiers and comment delimiters of a LanguageDefinition.
+    // The colors of the first GetNbColorizedLines() lines can be read while the worker is running:
+    // the other lines are displayed uncolored.
+    //
+    // The colorizer does not copy the code: the caller's code may be freed at any time after it is displayed,
+    // so that it is only read by Step() (on the main thread, while the snippet is displayed),
+    // which hands the next chunks to the worker (a few chunks at most are queued), and collects the colorized ones.
+    // The worker only reads its copies of the chunks, and the colors are only read and written by the main thread:
+    // the line offsets may then grow while the worker is running (see Extend()).
+    class SnippetColorizer
+    {
+    public:
+        struct ColorSpan
+        {
+            uint32_t Start;                     // Offsets within the line
+            uint32_t End;
+            TextEditor::PaletteIndex ColorIndex;
+        };
+
+        // lineOffsets (the offset of each line start in the code) is not copied: it must outlive the colorizer
+        SnippetColorizer(const std::vector<size_t>& lineOffsets, size_t codeSize, const TextEditor::LanguageDefinition& languageDefinition);
+        ~SnippetColorizer();                    // Cancels and joins the worker
+        SnippetColorizer(const SnippetColorizer&) = delete;
+        SnippetColorizer& operator=(const SnippetColorizer&) = delete;
+
+        int GetNbColorizedLines() const;
+        // Returns the spans of a colorized line (line < GetNbColorizedLines()). Text outside the spans uses the Default color.
+        void GetLineSpans(int line, const ColorSpan** spansBegin, const ColorSpan** spansEnd) const;
+        // Call this once per frame while the snippet is displayed: collects the colorized chunks,
+        // and hands the next chunks of the code to the worker
+        // (without threads, i.e. emscripten without pthreads, colorizes one chunk)
+        void Step(const std::string& code);
+        // Call this when text was appended to the code, after the new lines were appended to lineOffsets:
+        // only the new lines (and the previous last line, which may have grown) are colorized
+        void Extend(size_t codeSize);
+
+        size_t SizeBytes() const;               // Size of the colors, and of the chunks waiting for the worker
+
+    private:
+        struct Chunk
+        {
+            int NbLines = 0;
+            size_t EndOffset = 0;               // ChunkEndOffset when the chunk was copied for the worker
+            std::vector<ColorSpan> Spans;
+            std::vector<uint32_t> LineFirstSpan; // One per line, plus a final end marker
+        };
+
+        // A copy of the code of a chunk, waiting for the worker (or colorized by it)
+        struct PendingChunk
+        {
+            int ChunkIdx = 0;
+            std::string Text;
+            std::vector<uint32_t> LineStarts;   // Offset of each line start in Text
+            Chunk Result;                       // NbLines and EndOffset are set by MakePendingChunk
+        };
+
+        size_t ChunkFirstLine(int chunkIdx) const;
+        size_t ChunkEndOffset(int chunkIdx) const;
+        int NbLinesInChunk(int chunkIdx) const;
+        PendingChunk MakePendingChunk(int chunkIdx, const std::string& code) const;
+        void ColorizeChunk(PendingChunk& pendingChunk);  // Worker thread
+        void InstallChunk(PendingChunk& pendingChunk);   // Main thread
+        void UpdateNbColorizedLines();
+        void ColorizeLine(const char* lineBegin, const char* lineEnd, std::vector<ColorSpan>& spans);
+
+        const std::vector<size_t>& mLineOffsets;
+        size_t mCodeSize = 0;
+        const TextEditor::LanguageDefinition& mLanguageDefinition;
+
+        // Main thread only
+        std::vector<Chunk> mChunks;
+        int mNbColorizedLines = 0;
+        int mNextChunkToQueue = 0;
+        size_t mColorsSizeBytes = 0;
+
+        // Worker only: the block comment state at the end of each chunk (chunks are colorized in order)
+        std::vector<char> mChunkEndsInBlockComment;
+        bool mInBlockComment = false;
+        std::string mIdentifierBuffer;
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<PendingChunk> mPendingChunks;    // Protected by mMutex
+        std::deque<PendingChunk> mColorizedChunks;  // Protected by mMutex
+
+        std::atomic<size_t> mPendingSizeBytes { 0 };
+        std::atomic<bool> mCancelled { false };
+        std::thread mWorker;
+    };
+}
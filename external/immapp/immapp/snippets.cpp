@@ -1,15 +1,22 @@
 #include "snippets.h"
 #include "ImGuiColorTextEdit/TextEditor.h"
 #include "imgui.h"
+#include "imgui_internal.h"
 #include "hello_imgui/icons_font_awesome_4.h"
 #include "immapp/code_utils.h"
 #include "immapp/clock.h"
+#include "immapp/snippet_colorizer.h"
 #include "imgui_md_wrapper/imgui_md_wrapper.h"
 #ifdef __EMSCRIPTEN__
 #include "immapp/js_clipboard_tricks.h"
 #endif
 
+#include <algorithm>
+#include <cstring>
+#include <list>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include "fplus/fplus.hpp"
 
 
@@ -27,24 +34,29 @@ namespace Snippets
             editor.SetPalette(TextEditor::GetMarianaPalette());
     }
 
-    void _SetLanguage(TextEditor& editor, SnippetLanguage lang)
+    const TextEditor::LanguageDefinition& _GetLanguageDefinition(SnippetLanguage lang)
     {
-        if (lang == SnippetLanguage::Cpp)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::CPlusPlus());
-        else if (lang == SnippetLanguage::Hlsl)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::HLSL());
+        if (lang == SnippetLanguage::Hlsl)
+            return TextEditor::LanguageDefinition::HLSL();
         else if (lang == SnippetLanguage::Glsl)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::GLSL());
+            return TextEditor::LanguageDefinition::GLSL();
         else if (lang == SnippetLanguage::C)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::C());
+            return TextEditor::LanguageDefinition::C();
         else if (lang == SnippetLanguage::Sql)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::SQL());
+            return TextEditor::LanguageDefinition::SQL();
         else if (lang == SnippetLanguage::AngelScript)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::AngelScript());
+            return TextEditor::LanguageDefinition::AngelScript();
         else if (lang == SnippetLanguage::Lua)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::Lua());
+            return TextEditor::LanguageDefinition::Lua();
         else if (lang == SnippetLanguage::Python)
-            editor.SetLanguageDefinition(TextEditor::LanguageDefinition::Python());
+            return TextEditor::LanguageDefinition::Python();
+        else
+            return TextEditor::LanguageDefinition::CPlusPlus();
+    }
+
+    void _SetLanguage(TextEditor& editor, SnippetLanguage lang)
+    {
+        editor.SetLanguageDefinition(_GetLanguageDefinition(lang));
     }
 
 #ifdef __EMSCRIPTEN__
@@ -76,37 +88,393 @@ namespace Snippets
 #endif // #ifdef __EMSCRIPTEN__
 
 
+    struct _SnippetCacheEntry
+    {
+        TextEditor Editor;
+        std::string DisplayedCode;          // Code (unindented if required), with a final empty line
+        int NbLines = 0;                    // Number of lines in the original code
+        std::vector<size_t> LineOffsets;    // Virtualized snippets: offset of each line start in the code
+        int IndentSize = 0;                 // Virtualized snippets: number of leading chars skipped on each line
+        size_t IndentScanFromLine = 0;      // Virtualized snippets: first line which may set IndentSize (while it is unknown)
+        size_t CodeSize = 0;                // Virtualized snippets: size and fingerprint of the indexed code
+        ImGuiID CodeFingerprint = 0;
+        SnippetLanguage Language = SnippetLanguage::Cpp;
+        SnippetTheme Palette = SnippetTheme::Light;
+        bool DeIndentCode = true;
+        std::unique_ptr<SnippetColorizer> Colorizer; // Virtualized snippets: syntax colors, computed in the background
+        size_t SizeBytes = 0;               // Memory accounted in SnippetCacheStats.CodeBytes
+        double TimeClickCopyButton = -1.;
+        int LastFrame = -1;
+        std::list<ImGuiID>::iterator LruPosition;
+    };
+
+
+    class _SnippetCache
+    {
+    public:
+        _SnippetCacheEntry& Get(ImGuiID id, const SnippetData& snippetData)
+        {
+            int frame = ImGui::GetFrameCount();
+            auto it = mEntries.find(id);
+            if (it != mEntries.end())
+            {
+                ++mStats.NbHits;
+                auto& entry = it->second;
+                mLru.splice(mLru.begin(), mLru, entry.LruPosition);
+                entry.LastFrame = frame;
+                if (entry.Colorizer)
+                {
+                    _UpdateVirtualizedEntry(entry, snippetData);
+                    _UpdateSizeBytes(entry, _VirtualizedSizeBytes(entry));
+                }
+                return entry;
+            }
+
+            ++mStats.NbMisses;
+            auto& entry = mEntries[id];
+            _SetLanguage(entry.Editor, snippetData.Language);
+            _SetTheme(entry.Editor, snippetData.Palette);
+            if (snippetData.Virtualized)
+            {
+                _IndexVirtualizedEntry(entry, snippetData);
+                entry.SizeBytes = _VirtualizedSizeBytes(entry);
+            }
+            else
+            {
+                entry.DisplayedCode = snippetData.DeIndentCode ? CodeUtils::UnindentCode(snippetData.Code) : snippetData.Code;
+                entry.DisplayedCode += "\n"; // add final empty line, so that the editor shows all
+                entry.NbLines = (int)fplus::count('\n', snippetData.Code) + 1;
+                entry.Editor.SetText(entry.DisplayedCode);
+                entry.SizeBytes = entry.DisplayedCode.size();
+            }
+            entry.LastFrame = frame;
+            mLru.push_front(id);
+            entry.LruPosition = mLru.begin();
+            mStats.CodeBytes += entry.SizeBytes;
+
+            Evict();
+            return entry;
+        }
+
+        void SetCapacity(int capacity)
+        {
+            mCapacity = capacity;
+            Evict();
+        }
+
+        void Clear()
+        {
+            mEntries.clear();
+            mLru.clear();
+            mCodeHashes.clear();
+            mStats.CodeBytes = 0;
+        }
+
+        // The hash of a snippet code, memoized by the address and size of the code, so that large snippets
+        // are not hashed at each frame. It is recomputed when a sample of the code changes
+        // (e.g. when another code is stored at the same address).
+        ImGuiID CodeHash(const std::string& code)
+        {
+            const size_t kNbSamples = 16, kSampleSize = 64;
+            if (code.size() <= kNbSamples * kSampleSize)
+                return ImHashStr(code.data(), code.size());
+
+            ImGuiID sampleHash = 0;
+            for (size_t i = 0; i < kNbSamples; ++i)
+            {
+                size_t offset = code.size() * i / kNbSamples;
+                sampleHash = ImHashData(code.data() + offset, std::min(kSampleSize, code.size() - offset), sampleHash);
+            }
+
+            int frame = ImGui::GetFrameCount();
+            auto& memo = mCodeHashes[{ code.data(), code.size() }];
+            if (memo.LastFrame < 0 || memo.SampleHash != sampleHash)
+            {
+                memo.SampleHash = sampleHash;
+                memo.Hash = ImHashStr(code.data(), code.size());
+            }
+            memo.LastFrame = frame;
+
+            // Forget the codes which were not displayed during this frame, when there are too many
+            if (mCodeHashes.size() > 2 * (size_t)mCapacity)
+            {
+                for (auto it = mCodeHashes.begin(); it != mCodeHashes.end(); )
+                    it = (it->second.LastFrame == frame) ? std::next(it) : mCodeHashes.erase(it);
+            }
+            return memo.Hash;
+        }
+
+        SnippetCacheStats Stats() const
+        {
+            SnippetCacheStats r = mStats;
+            r.NbEntries = (int)mEntries.size();
+            return r;
+        }
+
+    private:
+        // The colors of virtualized snippets grow while they are computed
+        void _UpdateSizeBytes(_SnippetCacheEntry& entry, size_t sizeBytes)
+        {
+            mStats.CodeBytes = mStats.CodeBytes - entry.SizeBytes + sizeBytes;
+            entry.SizeBytes = sizeBytes;
+        }
+
+        static size_t _VirtualizedSizeBytes(const _SnippetCacheEntry& entry)
+        {
+            return entry.LineOffsets.capacity() * sizeof(size_t) + entry.Colorizer->SizeBytes();
+        }
+
+        // A hash of a few samples of code[0, size), including its end: it tells (in O(1)) whether the indexed code
+        // is still the same, or is a prefix of the current code (e.g. a log to which lines were appended)
+        static ImGuiID _CodeFingerprint(const std::string& code, size_t size)
+        {
+            const size_t kNbSamples = 16, kSampleSize = 64;
+            if (size <= kNbSamples * kSampleSize)
+                return ImHashData(code.data(), size);
+            ImGuiID r = ImHashData(&size, sizeof(size));
+            for (size_t i = 0; i <= kNbSamples; ++i)
+            {
+                size_t offset = std::min(size * i / kNbSamples, size - kSampleSize);
+                r = ImHashData(code.data() + offset, kSampleSize, r);
+            }
+            return r;
+        }
+
+        // Builds the line index and the colorizer of a virtualized snippet
+        static void _IndexVirtualizedEntry(_SnippetCacheEntry& entry, const SnippetData& snippetData)
+        {
+            entry.Colorizer.reset();
+            entry.LineOffsets.clear();
+            entry.LineOffsets.push_back(0);
+            entry.IndentSize = 0;
+            entry.IndentScanFromLine = 0;
+            entry.Language = snippetData.Language;
+            entry.Palette = snippetData.Palette;
+            entry.DeIndentCode = snippetData.DeIndentCode;
+            _IndexLines(entry, snippetData.Code, 0);
+            entry.LineOffsets.shrink_to_fit();
+            entry.Colorizer = std::make_unique<SnippetColorizer>(
+                entry.LineOffsets, snippetData.Code.size(), _GetLanguageDefinition(snippetData.Language));
+        }
+
+        // A virtualized snippet is identified by its position in the ID stack only, so that its code may change:
+        //   - when text was appended to the code, only the new lines are indexed and colorized
+        //   - when the code shrinks or its previous content changed, it is indexed again
+        void _UpdateVirtualizedEntry(_SnippetCacheEntry& entry, const SnippetData& snippetData)
+        {
+            const std::string& code = snippetData.Code;
+            if (snippetData.Palette != entry.Palette)
+            {
+                _SetTheme(entry.Editor, snippetData.Palette);
+                entry.Palette = snippetData.Palette;
+            }
+            bool isSameSettings = snippetData.Language == entry.Language && snippetData.DeIndentCode == entry.DeIndentCode;
+            if (isSameSettings && code.size() == entry.CodeSize && _CodeFingerprint(code, code.size()) == entry.CodeFingerprint)
+                return;
+
+            if (isSameSettings && code.size() > entry.CodeSize && _CodeFingerprint(code, entry.CodeSize) == entry.CodeFingerprint)
+            {
+                _IndexLines(entry, code, entry.CodeSize);
+                entry.Colorizer->Extend(code.size());
+            }
+            else
+            {
+                _SetLanguage(entry.Editor, snippetData.Language);
+                _IndexVirtualizedEntry(entry, snippetData);
+                ++mStats.NbMisses;
+            }
+        }
+
+        // Appends the lines of code[fromOffset, end) to the line index of a virtualized snippet (single memchr pass)
+        static void _IndexLines(_SnippetCacheEntry& entry, const std::string& code, size_t fromOffset)
+        {
+            const char* begin = code.data();
+            const char* end = begin + code.size();
+            for (const char* p = begin + fromOffset; p < end; )
+            {
+                const char* eol = (const char*)memchr(p, '\n', (size_t)(end - p));
+                if (eol == nullptr)
+                    break;
+                p = eol + 1;
+                entry.LineOffsets.push_back((size_t)(p - begin));
+            }
+            entry.NbLines = (int)entry.LineOffsets.size();
+            entry.CodeSize = code.size();
+            entry.CodeFingerprint = _CodeFingerprint(code, code.size());
+
+            // The main indentation is the one of the first non blank line
+            // (as opposed to UnindentCode, lines with a smaller indentation are not shifted).
+            // Until it is found, the last line is scanned again when the code grows (it may still be blank).
+            if (entry.DeIndentCode && entry.IndentScanFromLine < entry.LineOffsets.size())
+            {
+                for (size_t line = entry.IndentScanFromLine; line < entry.LineOffsets.size(); ++line)
+                {
+                    size_t lineStart = entry.LineOffsets[line];
+                    size_t i = lineStart;
+                    while (i < code.size() && (code[i] == ' ' || code[i] == '\t'))
+                        ++i;
+                    if (i < code.size() && code[i] != '\n' && code[i] != '\r')
+                    {
+                        entry.IndentSize = (int)(i - lineStart);
+                        entry.IndentScanFromLine = (size_t)-1;
+                        break;
+                    }
+                }
+                if (entry.IndentScanFromLine != (size_t)-1)
+                    entry.IndentScanFromLine = entry.LineOffsets.size() - 1;
+            }
+        }
+
+        // Evicts the least recently displayed snippets (but never those displayed during this frame)
+        void Evict()
+        {
+            int frame = ImGui::GetFrameCount();
+            while ((int)mEntries.size() > mCapacity && !mLru.empty())
+            {
+                ImGuiID oldestId = mLru.back();
+                auto& oldest = mEntries.at(oldestId);
+                if (oldest.LastFrame == frame)
+                    break;
+                mStats.CodeBytes -= oldest.SizeBytes;
+                mEntries.erase(oldestId);
+                mLru.pop_back();
+                ++mStats.NbEvictions;
+            }
+        }
+
+        struct _CodeHashMemo
+        {
+            ImGuiID SampleHash = 0;
+            ImGuiID Hash = 0;
+            int LastFrame = -1;
+        };
+
+        std::unordered_map<ImGuiID, _SnippetCacheEntry> mEntries;
+        std::list<ImGuiID> mLru;            // Most recently displayed first
+        std::map<std::pair<const char*, size_t>, _CodeHashMemo> mCodeHashes;
+        int mCapacity = 256;
+        SnippetCacheStats mStats;
+    };
+
+    static _SnippetCache gSnippetCache;
+
+
+    // Renders the visible lines of a virtualized snippet (the editor is only used for its palette)
+    void _RenderVirtualizedSnippet(const SnippetData& snippetData, _SnippetCacheEntry& cacheEntry, ImGuiID id, ImVec2 size)
+    {
+        const auto& palette = cacheEntry.Editor.GetPalette();
+        ImU32 colorBackground = palette[(int)TextEditor::PaletteIndex::Background];
+        ImU32 colorLineNumber = palette[(int)TextEditor::PaletteIndex::LineNumber];
+        ImU32 colorText = palette[(int)TextEditor::PaletteIndex::Default];
+
+        ImGui::PushStyleColor(ImGuiCol_ChildBg, colorBackground);
+        ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(ImGui::GetStyle().ItemSpacing.x, 0.f));
+        ImGuiChildFlags childFlags = snippetData.Border ? ImGuiChildFlags_Border : ImGuiChildFlags_None;
+        if (ImGui::BeginChild(id, size, childFlags, ImGuiWindowFlags_HorizontalScrollbar))
+        {
+            const std::string& code = snippetData.Code;
+            const char* codeBegin = code.data();
+            const char* codeEnd = codeBegin + code.size();
+            const auto& offsets = cacheEntry.LineOffsets;
+            int lineNumberWidth = (int)std::to_string(cacheEntry.NbLines).size();
+
+            SnippetColorizer& colorizer = *cacheEntry.Colorizer;
+            colorizer.Step(code);
+            int nbColorizedLines = colorizer.GetNbColorizedLines();
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(cacheEntry.NbLines);
+            while (clipper.Step())
+            {
+                for (int line = clipper.DisplayStart; line < clipper.DisplayEnd; ++line)
+                {
+                    const char* lineBegin = codeBegin + offsets[(size_t)line];
+                    const char* lineEnd = (line + 1 < (int)offsets.size()) ? codeBegin + offsets[(size_t)line + 1] - 1 : codeEnd;
+                    if (lineEnd > lineBegin && lineEnd[-1] == '\r')
+                        --lineEnd;
+                    const char* displayBegin = lineBegin;
+                    for (int i = 0; i < cacheEntry.IndentSize && displayBegin < lineEnd && (*displayBegin == ' ' || *displayBegin == '\t'); ++i)
+                        ++displayBegin;
+
+                    ImGui::PushStyleColor(ImGuiCol_Text, colorLineNumber);
+                    ImGui::Text("%*d ", lineNumberWidth, line + 1);
+                    ImGui::PopStyleColor();
+                    ImGui::SameLine();
+
+                    // The line is drawn uncolored until the colorizer reaches it
+                    ImVec2 pos = ImGui::GetCursorScreenPos();
+                    float textStartX = pos.x;
+                    auto drawSegment = [&](const char* segmentBegin, const char* segmentEnd, ImU32 color) {
+                        if (segmentBegin >= segmentEnd)
+                            return;
+                        drawList->AddText(pos, color, segmentBegin, segmentEnd);
+                        pos.x += ImGui::CalcTextSize(segmentBegin, segmentEnd).x;
+                    };
+                    const char* drawnUntil = displayBegin;
+                    if (line < nbColorizedLines)
+                    {
+                        const SnippetColorizer::ColorSpan *spansBegin, *spansEnd;
+                        colorizer.GetLineSpans(line, &spansBegin, &spansEnd);
+                        for (const SnippetColorizer::ColorSpan* span = spansBegin; span < spansEnd; ++span)
+                        {
+                            const char* spanBegin = std::max(lineBegin + span->Start, drawnUntil);
+                            const char* spanEnd = std::min(lineBegin + span->End, lineEnd);
+                            if (spanEnd <= spanBegin)
+                                continue;
+                            drawSegment(drawnUntil, spanBegin, colorText);
+                            drawSegment(spanBegin, spanEnd, palette[(int)span->ColorIndex]);
+                            drawnUntil = spanEnd;
+                        }
+                    }
+                    drawSegment(drawnUntil, lineEnd, colorText);
+                    ImGui::Dummy(ImVec2(pos.x - textStartX, ImGui::GetTextLineHeight()));
+                }
+            }
+        }
+        ImGui::EndChild();
+        ImGui::PopStyleVar();
+        ImGui::PopStyleColor();
+    }
+
+
     void ShowCodeSnippet(const SnippetData& snippetData, float width, int overrideHeightInLines)
     {
         if (width == 0.f)
             width = (ImGui::GetContentRegionMax().x  - ImGui::GetWindowContentRegionMin().x - ImGui::GetStyle().ItemSpacing.x);
 
-        auto id = ImGui::GetID(snippetData.Code.c_str());
-        ImGui::PushID(id);
-        static std::map<ImGuiID, TextEditor> gEditors;
-        static std::map<ImGuiID, double> timeClickCopyButton;
-
-        if (! fplus::map_contains(gEditors, id))
+        // The id is a hash of the code (and of the ID stack): the cache entry for a given id never needs to be updated.
+        // The code hash is memoized (see _SnippetCache::CodeHash).
+        // Virtualized snippets are identified by the ID stack only: their entry follows the changes of their code
+        // (see _SnippetCache::_UpdateVirtualizedEntry), so that a growing log is not indexed again at each frame.
+        ImGuiID id;
+        if (snippetData.Virtualized)
+            id = ImGui::GetID("##VirtualizedSnippet");
+        else
         {
-            gEditors.insert({id, TextEditor()});
-            auto& editor = gEditors.at(id);
-            _SetLanguage(editor, snippetData.Language);
-            _SetTheme(editor, snippetData.Palette);
+            ImGui::PushID((int)gSnippetCache.CodeHash(snippetData.Code));
+            id = ImGui::GetID("##Snippet");
+            ImGui::PopID();
         }
+        ImGui::PushID(id);
 
-        auto& editor = gEditors.at(id);
-        if (editor.GetText().empty() || snippetData.ReadOnly)
+        auto& cacheEntry = gSnippetCache.Get(id, snippetData);
+        auto& editor = cacheEntry.Editor;
+        if (!snippetData.Virtualized)
         {
-            std::string displayedCode = snippetData.DeIndentCode ? CodeUtils::UnindentCode(snippetData.Code) : snippetData.Code;
-            displayedCode += "\n"; // add final empty line, so that the editor shows all
-            if (editor.GetText() != displayedCode)
-                editor.SetText(displayedCode);
+            if (editor.IsReadOnly() != snippetData.ReadOnly)
+                editor.SetReadOnly(snippetData.ReadOnly);
+            // Restore the code if the user erased it
+            if (editor.GetTotalLines() <= 1 && editor.GetText().empty())
+                editor.SetText(cacheEntry.DisplayedCode);
         }
 
+        bool showCursorPosition = snippetData.ShowCursorPosition && !snippetData.Virtualized;
+
         ImGui::BeginGroup();
 
         // Title Line
-        bool hasTitleLine = ! snippetData.DisplayedFilename.empty() || snippetData.ShowCopyButton || snippetData.ShowCursorPosition;
+        bool hasTitleLine = ! snippetData.DisplayedFilename.empty() || snippetData.ShowCopyButton || showCursorPosition;
 
         float lineHeight;
         {
@@ -121,7 +489,7 @@ namespace Snippets
 
             int nbVisibleLines = 0;
             if ((snippetData.HeightInLines == 0) && (overrideHeightInLines==0))
-                nbVisibleLines = (int)fplus::count('\n', snippetData.Code) + 1;
+                nbVisibleLines = cacheEntry.NbLines;
             else if (overrideHeightInLines != 0)
                 nbVisibleLines = overrideHeightInLines;
             else
@@ -144,7 +512,7 @@ namespace Snippets
                 ImGui::Text("%s", snippetData.DisplayedFilename.c_str());
             }
 
-            if (snippetData.ShowCursorPosition)
+            if (showCursorPosition)
             {
                 float textX = snippetData.ShowCopyButton ? topRight.x - lineHeight * 6.f : topRight.x - lineHeight * 4.5f;
                 ImGui::SetCursorPos({textX, textY});
@@ -157,7 +525,7 @@ namespace Snippets
                 ImGui::SetCursorPos({topRight.x - lineHeight * 1.5f, topRight.y});
                 if (ImGui::Button(ICON_FA_COPY))
                 {
-                    timeClickCopyButton[id] = ImmApp::ClockSeconds();
+                    cacheEntry.TimeClickCopyButton = ImmApp::ClockSeconds();
                     ImGui::SetClipboardText(snippetData.Code.c_str());
                     #ifdef __EMSCRIPTEN__
                     JsClipboard_SetClipboardText(snippetData.Code.c_str());
@@ -165,10 +533,10 @@ namespace Snippets
                 }
 
                 bool wasCopiedRecently = false;
-                if (fplus::map_contains(timeClickCopyButton, id))
+                if (cacheEntry.TimeClickCopyButton >= 0.)
                 {
                     double now = ImmApp::ClockSeconds();
-                    double deltaTime = now - timeClickCopyButton.at(id);
+                    double deltaTime = now - cacheEntry.TimeClickCopyButton;
                     if (deltaTime < 0.7)
                         wasCopiedRecently = true;
                 }
@@ -183,10 +551,15 @@ namespace Snippets
         }
 
         ImGui::PushFont(ImGuiMd::GetCodeFont());
-        editor.Render(std::to_string(id).c_str(), false, editorSize, snippetData.Border);
+        if (snippetData.Virtualized)
+            _RenderVirtualizedSnippet(snippetData, cacheEntry, id, editorSize);
+        else
+        {
+            editor.Render(std::to_string(id).c_str(), false, editorSize, snippetData.Border);
 #ifdef __EMSCRIPTEN__
-        _ProcessClipboard_Emscripten(editor);
+            _ProcessClipboard_Emscripten(editor);
 #endif
+        }
 
         ImGui::PopFont();
         ImGui::EndGroup();
@@ -218,18 +591,25 @@ namespace Snippets
         int overrideHeightInLines = 0;
         if (equalVisibleLines)
         {
-            auto linesPerSnippets = fplus::transform([](const SnippetData& s) {return fplus::count('\n', s.Code);}, snippets);
+            // (virtualized snippets may be huge: they are not scanned, and count for their max height)
+            auto linesPerSnippets = fplus::transform([](const SnippetData& s) {
+                return s.Virtualized ? (size_t)s.MaxHeightInLines : fplus::count('\n', s.Code);
+            }, snippets);
             overrideHeightInLines = (int)fplus::maximum(linesPerSnippets) + 1;
         }
 
         float editorWidth = _EditorWidth(nbSideBySideEditors);
 
-        for (const auto& snippet: snippets)
+        for (size_t i = 0; i < snippets.size(); ++i)
         {
+            const auto& snippet = snippets[i];
             bool show = !hideIfEmpty || !snippet.Code.empty();
             if (show)
             {
+                // Virtualized snippets are identified by the ID stack only
+                ImGui::PushID((int)i);
                 ShowCodeSnippet(snippet, editorWidth, overrideHeightInLines);
+                ImGui::PopID();
                 ImGui::SameLine();
             }
         }
@@ -241,4 +621,20 @@ namespace Snippets
     {
         ShowSideBySideSnippets({snippet1, snippet2}, hideIfEmpty, equalVisibleLines);
     }
+
+
+    SnippetCacheStats GetSnippetCacheStats()
+    {
+        return gSnippetCache.Stats();
+    }
+
+    void SetSnippetCacheCapacity(int capacity)
+    {
+        gSnippetCache.SetCapacity(capacity);
+    }
+
+    void ClearSnippetCache()
+    {
+        gSnippetCache.Clear();
+    }
 }
@@ -60,12 +60,44 @@ namespace Snippets
 
         bool DeIndentCode = true;           // Keep the code indentation, but remove main indentation,
                                             // so that the displayed code start at column 1
+
+        bool Virtualized = false;           // For very large snippets (logs, generated code...): only the visible lines
+                                            // are rendered, using a line index. No edition, no cursor position.
+                                            // Syntax colors are computed by a worker thread while the snippet is displayed (lines are uncolored until then).
+                                            // The snippet is identified by the ImGui ID stack only (use PushID when several
+                                            // virtualized snippets share the same scope): when text is appended to its code
+                                            // (e.g. a log), only the new lines are indexed and colorized.
     };
 
 
+    // ShowCodeSnippet: the editor of a snippet is cached, keyed by a hash of its code (see below).
+    // For large codes, this hash only reads a few samples of the code: if the code is modified in place
+    // without changing its size, and outside of these samples, the cached editor (or line index, for virtualized snippets) still shows the previous code.
+    // Call ClearSnippetCache() after such a modification.
     void ShowCodeSnippet(const SnippetData& snippetData, float width = 0.f, int overrideHeightInLines = 0);
     void ShowSideBySideSnippets(const SnippetData& snippet1, const SnippetData& snippet2,
                                 bool hideIfEmpty = true, bool equalVisibleLines = true);
     void ShowSideBySideSnippets(const std::vector<SnippetData>& snippets ,
                                 bool hideIfEmpty = true, bool equalVisibleLines = true);
+
+
+    //
+    // Snippets cache: ShowCodeSnippet keeps an editor per snippet, keyed by a hash of its code
+    // (and of the ImGui ID stack), together with the unindented code and its number of lines.
+    // The hash of a large code is memoized by its address and size, and recomputed when a sample of the code changes:
+    // call ClearSnippetCache() if a large code is modified in place without changing its size.
+    // When the cache is full, the least recently displayed snippets are evicted.
+    //
+    struct SnippetCacheStats
+    {
+        int NbEntries = 0;
+        int NbHits = 0;
+        int NbMisses = 0;
+        int NbEvictions = 0;
+        size_t CodeBytes = 0;              // Total size of the cached code (and of the line indexes and syntax colors of virtualized snippets)
+    };
+
+    SnippetCacheStats GetSnippetCacheStats();
+    void SetSnippetCacheCapacity(int capacity);   // Default capacity: 256 snippets
+    void ClearSnippetCache();
 };
@@ -0,0 +1,208 @@
+#include "immapp/startup_timeline.h"
+#include "hello_imgui/hello_imgui.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+
+namespace ImmApp
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // CPU time consumed by the process (std::clock() cannot be used: it returns the wall time on MSVC)
+        double CpuSecondsNow()
+        {
+#if defined(_WIN32)
+            FILETIME creationTime, exitTime, kernelTime, userTime;
+            if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+                return 0.;
+            auto toSeconds = [](const FILETIME& t) {
+                // FILETIME is in units of 100 nanoseconds
+                uint64_t ticks = ((uint64_t)t.dwHighDateTime << 32) | (uint64_t)t.dwLowDateTime;
+                return (double)ticks * 1e-7;
+            };
+            return toSeconds(kernelTime) + toSeconds(userTime);
+#elif defined(CLOCK_PROCESS_CPUTIME_ID)
+            timespec t;
+            if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t) != 0)
+                return 0.;
+            return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+#else
+            return (double)std::clock() / (double)CLOCKS_PER_SEC;
+#endif
+        }
+
+        // Main thread only
+        struct StartupTimelineState
+        {
+            StartupTimeline Timeline;
+            Clock::time_point RunStart;
+            Clock::time_point LastMarkWall;
+            double RunStartCpu = 0.;
+            double LastMarkCpu = 0.;
+            bool FirstFrameStarted = false;
+        };
+
+        StartupTimelineState gStartupTimelineState;
+
+        // Adds a phase lasting from the previous mark until now
+        void AddPhase(const std::string& name)
+        {
+            auto& state = gStartupTimelineState;
+            if (state.Timeline.IsComplete)
+                return;
+            auto now = Clock::now();
+            double nowCpu = CpuSecondsNow();
+
+            StartupPhase phase;
+            phase.Name = name;
+            phase.StartSeconds = std::chrono::duration<double>(state.LastMarkWall - state.RunStart).count();
+            phase.WallSeconds = std::chrono::duration<double>(now - state.LastMarkWall).count();
+            phase.CpuSeconds = nowCpu - state.LastMarkCpu;
+            state.Timeline.Phases.push_back(phase);
+
+            state.Timeline.TotalWallSeconds = std::chrono::duration<double>(now - state.RunStart).count();
+            state.Timeline.TotalCpuSeconds = nowCpu - state.RunStartCpu;
+            state.LastMarkWall = now;
+            state.LastMarkCpu = nowCpu;
+        }
+
+        // Wraps a callback, so that the time spent before it (inside HelloImGui) and inside it are recorded
+        // (the callback is timed only for its first call)
+        void WrapStartupCallback(HelloImGui::VoidFunction& callback, const std::string& name)
+        {
+            if (!callback)
+                return;
+            auto fn = callback;
+            auto wasCalled = std::make_shared<bool>(false);
+            callback = [fn, name, wasCalled]()
+            {
+                if (*wasCalled)
+                {
+                    fn();
+                    return;
+                }
+                *wasCalled = true;
+                AddPhase("HelloImGui (before " + name + ")");
+                fn();
+                AddPhase(name);
+            };
+        }
+
+        std::string JsonEscape(const std::string& s)
+        {
+            std::string r;
+            for (char c: s)
+            {
+                if (c == '"' || c == '\\')
+                    r += '\\';
+                r += c;
+            }
+            return r;
+        }
+    } // anonymous namespace
+
+
+    StartupTimeline GetStartupTimeline()
+    {
+        return gStartupTimelineState.Timeline;
+    }
+
+
+    std::string StartupTimelineToChromeTrace(const StartupTimeline& timeline)
+    {
+        std::stringstream ss;
+        ss << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+        for (size_t i = 0; i < timeline.Phases.size(); ++i)
+        {
+            const auto& phase = timeline.Phases[i];
+            ss << "  {\"name\": \"" << JsonEscape(phase.Name) << "\", \"cat\": \"startup\", \"ph\": \"X\""
+               << ", \"ts\": " << (long long)(phase.StartSeconds * 1e6)
+               << ", \"dur\": " << (long long)(phase.WallSeconds * 1e6)
+               << ", \"pid\": 1, \"tid\": 1"
+               << ", \"args\": {\"cpu_ms\": " << phase.CpuSeconds * 1e3 << "}}";
+            if (i + 1 < timeline.Phases.size())
+                ss << ",";
+            ss << "\n";
+        }
+        ss << "]}\n";
+        return ss.str();
+    }
+
+
+    bool SaveStartupTimelineChromeTrace(const std::string& filename)
+    {
+        std::ofstream ofs(filename);
+        if (!ofs.good())
+        {
+            fprintf(stderr, "SaveStartupTimelineChromeTrace: could not open %s\n", filename.c_str());
+            return false;
+        }
+        ofs << StartupTimelineToChromeTrace(GetStartupTimeline());
+        return ofs.good();
+    }
+
+
+    namespace StartupTimelineInternal
+    {
+        // Called at the start of ImmApp::Run
+        void OnRunStart()
+        {
+            auto& state = gStartupTimelineState;
+            state = StartupTimelineState();
+            state.RunStart = Clock::now();
+            state.LastMarkWall = state.RunStart;
+            state.RunStartCpu = CpuSecondsNow();
+            state.LastMarkCpu = state.RunStartCpu;
+        }
+
+        // Called just before HelloImGui::Run (this should be done last, so that the other wrappers are included)
+        void InstallStartupTimelineCallbacks(HelloImGui::RunnerParams& runnerParams)
+        {
+            AddPhase("ImmApp (addons setup)");
+
+            auto& callbacks = runnerParams.callbacks;
+            WrapStartupCallback(callbacks.SetupImGuiConfig, "SetupImGuiConfig");
+            WrapStartupCallback(callbacks.SetupImGuiStyle, "SetupImGuiStyle");
+            WrapStartupCallback(callbacks.LoadAdditionalFonts, "LoadAdditionalFonts");
+            WrapStartupCallback(callbacks.PostInit, "PostInit");
+
+            // First frame: from the first PreNewFrame to the end of the first AfterSwap
+            auto fnPreNewFrame = callbacks.PreNewFrame;
+            callbacks.PreNewFrame = [fnPreNewFrame]()
+            {
+                auto& state = gStartupTimelineState;
+                if (!state.FirstFrameStarted)
+                {
+                    state.FirstFrameStarted = true;
+                    AddPhase("HelloImGui (before first frame)");
+                }
+                if (fnPreNewFrame)
+                    fnPreNewFrame();
+            };
+            auto fnAfterSwap = callbacks.AfterSwap;
+            callbacks.AfterSwap = [fnAfterSwap]()
+            {
+                if (fnAfterSwap)
+                    fnAfterSwap();
+                auto& state = gStartupTimelineState;
+                if (state.FirstFrameStarted && !state.Timeline.IsComplete)
+                {
+                    AddPhase("First frame");
+                    state.Timeline.IsComplete = true;
+                }
+            };
+        }
+    } // namespace StartupTimelineInternal
+
+} // namespace ImmApp
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <vector>
+
+
+namespace ImmApp
+{
+    /////////////////////////////////////////////////////////////////////////////////////////
+    //
+    // Startup timeline: where does the time go between ImmApp::Run() and the first displayed frame?
+    //
+    // ImmApp::Run records the startup phases delimited by the HelloImGui callbacks
+    // (SetupImGuiConfig, SetupImGuiStyle, LoadAdditionalFonts, PostInit, first frame).
+    // The time spent inside HelloImGui between two callbacks (window creation, GL loader,
+    // font atlas build, ini parsing, ...) is reported as "HelloImGui (before <next phase>)".
+    //
+    /////////////////////////////////////////////////////////////////////////////////////////
+
+    struct StartupPhase
+    {
+        std::string Name;
+        // Start time, relative to the start of ImmApp::Run (in seconds)
+        double StartSeconds = 0.;
+        // Wall clock duration (in seconds)
+        double WallSeconds = 0.;
+        // CPU time used by the process (all threads) during this phase (in seconds)
+        double CpuSeconds = 0.;
+    };
+
+    struct StartupTimeline
+    {
+        std::vector<StartupPhase> Phases;
+        double TotalWallSeconds = 0.;
+        double TotalCpuSeconds = 0.;
+        // IsComplete is true once the first frame was displayed
+        bool IsComplete = false;
+    };
+
+    // GetStartupTimeline returns the startup timeline of the last call to ImmApp::Run()
+    StartupTimeline GetStartupTimeline();
+
+    // StartupTimelineToChromeTrace returns the timeline in the Chrome trace event format
+    // (can be opened with chrome://tracing, or https://ui.perfetto.dev)
+    std::string StartupTimelineToChromeTrace(const StartupTimeline& timeline);
+
+    // SaveStartupTimelineChromeTrace saves the current startup timeline as a Chrome trace json file.
+    // Returns false in case of failure.
+    bool SaveStartupTimelineChromeTrace(const std::string& filename);
+} // namespace ImmApp
@@ -10,6 +10,30 @@ PYDEF_DIR = THIS_DIR
 STUB_DIR = THIS_DIR + "/../../../bindings/imgui_bundle/"
 
 
+# The stub of the NvgFramebuffer constructor (which is bound manually), inserted into the NvgFramebuffer class stub
+NVG_FRAMEBUFFER_CONSTRUCTOR_STUB = '''        # Warning: this constructor can be called only after a valid renderer backend (OpenGL) has been created
+        # (will call Init())
+        # If a pool is given, the allocation may be taken from it, and will be given back to it
+        # (in python, the framebuffer keeps the pool alive)
+        # NvgFramebuffer(    /* original C++ signature */
+        #             NVGcontext *vg,
+        #             int width, int height,
+        #             int nvgImageFlags,
+        #             NvgFramebufferPool* pool = nullptr
+        #             );
+        def __init__(self, vg: Context, width: int, height: int, nvg_image_flags: int, pool: Optional[NvgFramebufferPool] = None) -> None:
+            """ See NVGimageFlags"""
+            pass
+
+
+'''
+
+
+def _add_nvg_framebuffer_constructor_stub(stub_code: str) -> str:
+    bind_stub = "        # void Bind();    /* original C++ signature */\n"
+    return stub_code.replace(bind_stub, NVG_FRAMEBUFFER_CONSTRUCTOR_STUB + bind_stub)
+
+
 def main():
     print("autogenerate_nanovg")
     output_cpp_pydef_file = PYDEF_DIR + "/pybind_nanovg.cpp"
@@ -27,9 +51,14 @@ def main():
     options.function_names_replacements.add_last_replacement("^RGBf$", "rgb_f")
     options.function_names_replacements.add_last_replacement("ImGui", "Imgui")
     options.class_exclude_by_name__regex = "^NVGcolor$"  # contains a union...
+    # TextRowsBuffer and the "...Into" functions use reusable buffers, and are bound manually (with numpy arrays)
+    options.class_exclude_by_name__regex += "|^TextRowsBuffer$"
 
     # The entire nvgText API is oriented around C style strings, and needs adaptations
-    options.fn_exclude_by_name__regex = r"^nvgText|^nvgImageSize$"
+    options.fn_exclude_by_name__regex = r"^nvgText|^nvgImageSize$|^nvgcpp_.*Into$"
+    # The NvgFramebuffer constructor keeps its pool alive (py::keep_alive), and is bound manually
+    options.fn_exclude_by_name__regex += "|^NvgFramebuffer$"
+    options.postprocess_stub_function = _add_nvg_framebuffer_constructor_stub
 
     for letter in string.ascii_lowercase:
         options.type_replacements.add_last_replacement(
@@ -7,6 +7,11 @@
 #include "nanovg.h"
 #include "nvg_imgui/nvg_imgui.h"
 #include "nvg_imgui/nvg_cpp_text.h"
+#include "nvg_imgui/nvg_cpp_batch.h"
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
 
 
 namespace py = pybind11;
@@ -21,6 +26,106 @@ namespace py = pybind11;
 struct NVGcontext {};
 
 
+// Conversions from numpy arrays, for the batched drawing functions (nvg_cpp_batch.h)
+// (float64 arrays or non-contiguous arrays are accepted, but are converted, i.e. copied)
+namespace nvg_batch_arrays
+{
+    using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+    using IntArray = py::array_t<int, py::array::c_style | py::array::forcecast>;
+
+    // Returns the number of items in an array of shape (n, itemSize), or in a flat array of n * itemSize values
+    int NbItems(const py::array& a, int itemSize, const char* arrayName)
+    {
+        bool isValidShape =
+            (a.ndim() == 2 && a.shape(1) == itemSize)
+            || (a.ndim() == 1 && a.shape(0) % itemSize == 0);
+        if (!isValidShape)
+            throw std::runtime_error(
+                std::string("nanovg: ") + arrayName + " should be an array of shape (n, " + std::to_string(itemSize) + ")");
+        return (int)(a.size() / itemSize);
+    }
+
+    // Returns the RGBA colors (one per shape), or nullptr if colors is None
+    const float* ColorsData(const std::optional<FloatArray>& colors, int nbShapes)
+    {
+        if (!colors.has_value())
+            return nullptr;
+        if (NbItems(*colors, 4, "colors") != nbShapes)
+            throw std::runtime_error("nanovg: colors should contain one RGBA color per shape");
+        return colors->data();
+    }
+}
+
+
+// A numpy array which is reused between calls (it grows geometrically), for the reusable text buffers.
+// View() returns its first values without copy: the view keeps the storage alive,
+// but its values are overwritten by the next call which fills the storage.
+template<typename T>
+struct ReusableArray
+{
+    py::array_t<T> storage = py::array_t<T>(0);
+    py::ssize_t size = 0;
+
+    // Returns a pointer to n values (their previous content is lost)
+    T* Resize(py::ssize_t n)
+    {
+        if (n > storage.size())
+            storage = py::array_t<T>(std::max(n, storage.size() + storage.size() / 2));
+        size = n;
+        return storage.mutable_data();
+    }
+
+    py::array View() const
+    {
+        return py::array_t<T>({ size }, { (py::ssize_t)sizeof(T) }, storage.data(), storage);
+    }
+};
+
+
+// TextRowsBuffer, with numpy copies of its rows (reused between calls), so that the python properties are views
+struct TextRowsBuffer_Numpy : public TextRowsBuffer
+{
+    ReusableArray<int> startsArray, endsArray;
+    ReusableArray<float> widthsArray, minxsArray, maxxsArray;
+
+    void UpdateArrays()
+    {
+        py::ssize_t nbRows = (py::ssize_t)NbRows();
+        std::copy(starts.begin(), starts.end(), startsArray.Resize(nbRows));
+        std::copy(ends.begin(), ends.end(), endsArray.Resize(nbRows));
+        std::copy(widths.begin(), widths.end(), widthsArray.Resize(nbRows));
+        std::copy(minxs.begin(), minxs.end(), minxsArray.Resize(nbRows));
+        std::copy(maxxs.begin(), maxxs.end(), maxxsArray.Resize(nbRows));
+    }
+};
+
+
+// The glyph positions of a text, filled by text_glyph_positions_into() (reused between calls)
+struct GlyphPositionsBuffer_Numpy
+{
+    std::vector<NVGglyphPosition> positions;
+    ReusableArray<int> offsetsArray;
+    ReusableArray<float> xsArray, minxsArray, maxxsArray;
+
+    void UpdateArrays(const char* text)
+    {
+        py::ssize_t nbGlyphs = (py::ssize_t)positions.size();
+        int* offsets = offsetsArray.Resize(nbGlyphs);
+        float* xs = xsArray.Resize(nbGlyphs);
+        float* minxs = minxsArray.Resize(nbGlyphs);
+        float* maxxs = maxxsArray.Resize(nbGlyphs);
+        for (py::ssize_t i = 0; i < nbGlyphs; ++i)
+        {
+            const NVGglyphPosition& position = positions[(size_t)i];
+            offsets[i] = (int)(position.str - text);
+            xs[i] = position.x;
+            minxs[i] = position.minx;
+            maxxs[i] = position.maxx;
+        }
+    }
+};
+
+
 void py_init_module_nanovg(py::module& m)
 {
     py::class_<NVGcontext, std::unique_ptr<NVGcontext, py::nodelete>>
@@ -836,13 +941,33 @@ void py_init_module_nanovg(py::module& m)
             .def_readwrite("height", &NvgImgui::NvgFramebuffer::Height, "")
             .def_readwrite("nvg_image_flags", &NvgImgui::NvgFramebuffer::NvgImageFlags, "")
             .def_readwrite("texture_id", &NvgImgui::NvgFramebuffer::TextureId, "")
-            .def(py::init<NVGcontext *, int, int, int>(),
-                py::arg("vg"), py::arg("width"), py::arg("height"), py::arg("nvg_image_flags"),
-                "See NVGimageFlags")
+            .def_readwrite("capacity_width", &NvgImgui::NvgFramebuffer::CapacityWidth, "Size of the texture, which may be larger than Width x Height after Resize() (OpenGL only)")
+            .def_readwrite("capacity_height", &NvgImgui::NvgFramebuffer::CapacityHeight, "Size of the texture, which may be larger than Width x Height after Resize() (OpenGL only)")
             .def("bind",
                 &NvgImgui::NvgFramebuffer::Bind, "Make the framebuffer the current render target")
             .def("unbind",
                 &NvgImgui::NvgFramebuffer::Unbind, "Restore the previous render target")
+            .def("resize",
+                &NvgImgui::NvgFramebuffer::Resize,
+                py::arg("width"), py::arg("height"),
+                " Resize: changes the size of the framebuffer, and reuses its texture when the new size fits in it.\n Otherwise, the capacity grows by 1.5x at least, so that a drag-resize does not reallocate at each frame\n (and a texture more than 4 times too large is reallocated).\n Note: TextureId may change. Display the texture with uv1 = TextureUv1().")
+            .def("texture_uv1",
+                &NvgImgui::NvgFramebuffer::TextureUv1, " The uv1 coordinates to use when displaying TextureId with ImGui::Image\n (the texture may be larger than Width x Height)")
+            .def("invalidate",
+                &NvgImgui::NvgFramebuffer::Invalidate, " Invalidate: the next call to RenderNvgToFrameBufferIfChanged will redraw the framebuffer\n (Resize() also invalidates it)")
+            ;
+
+
+        auto pyNsNvgImgui_ClassNvgFramebufferPool =
+            py::class_<NvgImgui::NvgFramebufferPool>
+                (pyNsNvgImgui, "NvgFramebufferPool", " NvgFramebufferPool: keeps the textures of destroyed or resized NvgFramebuffers, so that they can be reused\n by other framebuffers (e.g. several resizable NanoVG panels), instead of being deleted and reallocated.\n Warning: the pool must outlive its framebuffers, and be destroyed when the renderer backend\n and the NVGcontext are still valid")
+            .def(py::init<int>(),
+                py::arg("max_pooled_allocations") = 8,
+                "At most maxPooledAllocations unused textures are kept (the oldest ones are deleted first)")
+            .def("nb_pooled_allocations",
+                &NvgImgui::NvgFramebufferPool::NbPooledAllocations, "Number of unused textures in the pool")
+            .def("clear",
+                &NvgImgui::NvgFramebufferPool::Clear, "Deletes the unused textures")
             ;
 
 
@@ -854,7 +979,12 @@ void py_init_module_nanovg(py::module& m)
         pyNsNvgImgui.def("render_nvg_to_frame_buffer",
             NvgImgui::RenderNvgToFrameBuffer,
             py::arg("vg"), py::arg("texture"), py::arg("draw_func"), py::arg("clear_color") = ImVec4(0.f, 0.f, 0.f, 1.f),
-            " Render the given drawing function to the given framebuffer\n If clearColor.w > 0., the background will be cleared with this color");
+            " Render the given drawing function to the given framebuffer\n If clearColor.w > 0., the background will be cleared with this color\n (the framebuffer is invalidated: the next call to RenderNvgToFrameBufferIfChanged will redraw it)");
+
+        pyNsNvgImgui.def("render_nvg_to_frame_buffer_if_changed",
+            NvgImgui::RenderNvgToFrameBufferIfChanged,
+            py::arg("vg"), py::arg("texture"), py::arg("draw_func"), py::arg("content_version"), py::arg("clear_color") = ImVec4(0.f, 0.f, 0.f, 1.f),
+            " Render the given drawing function to the given framebuffer, only if contentVersion changed\n since the last call (or if the framebuffer was resized or invalidated).\n Otherwise, the framebuffer texture is left untouched: a static drawing costs nothing.\n contentVersion is any value (counter, hash...) which changes when the inputs of the drawing change\n (it is signed, so that a python hash() can be used).\n Returns True if the drawing function was called.");
     } // </namespace NvgImgui>
     ////////////////////    </generated_from:nvg_imgui.h>    ////////////////////
 
@@ -957,4 +1087,155 @@ void py_init_module_nanovg(py::module& m)
 
     // </litgen_pydef> // Autogenerated code end
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!  AUTOGENERATED CODE END !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+
+    ////////////////////    NvgFramebuffer constructor (bound manually: the framebuffer keeps its pool alive)    ////////////////////
+    {
+        auto pyClassNvgFramebuffer = py::reinterpret_borrow<py::class_<NvgImgui::NvgFramebuffer>>(
+            m.attr("nvg_imgui").attr("NvgFramebuffer"));
+        pyClassNvgFramebuffer.def(py::init<NVGcontext *, int, int, int, NvgImgui::NvgFramebufferPool *>(),
+            py::arg("vg"), py::arg("width"), py::arg("height"), py::arg("nvg_image_flags"), py::arg("pool") = py::none(),
+            "See NVGimageFlags",
+            py::keep_alive<1, 6>());
+    }
+
+
+    ////////////////////    Batched drawing (nvg_cpp_batch.h), from numpy arrays    ////////////////////
+    {
+        using namespace nvg_batch_arrays;
+
+        m.def("draw_polylines",
+            [](NVGcontext* ctx, const FloatArray& points, const IntArray& offsets,
+               const std::optional<FloatArray>& colors, bool closed, bool fill)
+            {
+                int nbPoints = NbItems(points, 2, "points");
+                if (offsets.ndim() != 1 || offsets.size() < 1)
+                    throw std::runtime_error("nanovg: offsets should be a 1D array of nb_polylines + 1 indices");
+                int nbPolylines = (int)offsets.size() - 1;
+                const int* offsetsData = offsets.data();
+                for (int i = 0; i <= nbPolylines; ++i)
+                {
+                    bool isValidOffset = offsetsData[i] >= 0 && offsetsData[i] <= nbPoints
+                        && (i == 0 || offsetsData[i] >= offsetsData[i - 1]);
+                    if (!isValidOffset)
+                        throw std::runtime_error("nanovg: offsets should be increasing indices in [0, nb_points]");
+                }
+                const float* colorsData = ColorsData(colors, nbPolylines);
+                nvgcpp_DrawPolylines(ctx, points.data(), offsetsData, nbPolylines, colorsData, closed, fill);
+            },
+            py::arg("ctx"), py::arg("points"), py::arg("offsets"), py::arg("colors") = py::none(),
+            py::arg("closed") = false, py::arg("fill") = false,
+            " Draws many polylines with a single call.\n"
+            " points: array of shape (nb_points, 2)\n"
+            " offsets: nb_polylines + 1 indices into points: the polyline i uses points[offsets[i]:offsets[i+1]]\n"
+            " colors: optional array of shape (nb_polylines, 4) (RGBA floats). If None, the current style is used.\n"
+            " If fill is True the polylines are filled, otherwise they are stroked.");
+
+        m.def("draw_circles",
+            [](NVGcontext* ctx, const FloatArray& centers, const std::optional<FloatArray>& radii, float radius,
+               const std::optional<FloatArray>& colors, bool fill)
+            {
+                int nbCircles = NbItems(centers, 2, "centers");
+                const float* radiiData = nullptr;
+                if (radii.has_value())
+                {
+                    if (radii->size() != nbCircles)
+                        throw std::runtime_error("nanovg: radii should contain one radius per circle");
+                    radiiData = radii->data();
+                }
+                const float* colorsData = ColorsData(colors, nbCircles);
+                nvgcpp_DrawCircles(ctx, centers.data(), nbCircles, radiiData, radius, colorsData, fill);
+            },
+            py::arg("ctx"), py::arg("centers"), py::arg("radii") = py::none(), py::arg("radius") = 1.f,
+            py::arg("colors") = py::none(), py::arg("fill") = true,
+            " Draws many circles (e.g. markers) with a single call.\n"
+            " centers: array of shape (nb_circles, 2)\n"
+            " radii: optional array of shape (nb_circles,). If None, radius is used for all circles.\n"
+            " colors: optional array of shape (nb_circles, 4) (RGBA floats). If None, the current style is used.\n"
+            " If fill is True the circles are filled, otherwise they are stroked.");
+
+        m.def("draw_rects",
+            [](NVGcontext* ctx, const FloatArray& rects, const std::optional<FloatArray>& colors, bool fill)
+            {
+                int nbRects = NbItems(rects, 4, "rects");
+                const float* colorsData = ColorsData(colors, nbRects);
+                nvgcpp_DrawRects(ctx, rects.data(), nbRects, colorsData, fill);
+            },
+            py::arg("ctx"), py::arg("rects"), py::arg("colors") = py::none(), py::arg("fill") = true,
+            " Draws many rectangles with a single call.\n"
+            " rects: array of shape (nb_rects, 4), each row being (x, y, w, h)\n"
+            " colors: optional array of shape (nb_rects, 4) (RGBA floats). If None, the current style is used.\n"
+            " If fill is True the rectangles are filled, otherwise they are stroked.");
+    }
+
+
+    ////////////////////    Text line breaking and glyph positions into reusable buffers (nvg_cpp_text.h)    ////////////////////
+    py::class_<TextRowsBuffer_Numpy>(m, "TextRowsBuffer",
+        " The rows of a text broken into lines by text_break_lines_into(), stored as numpy arrays which are reused between calls.\n"
+        " The rows are given as byte offsets in the UTF-8 encoded text (i.e. text.encode()[starts[i]:ends[i]]).\n"
+        " starts, ends, widths, minxs and maxxs return views of these arrays (without copy):\n"
+        " their values are overwritten by the next call to text_break_lines_into() (copy them to keep them).")
+        .def(py::init<>())
+        .def("nb_rows", &TextRowsBuffer_Numpy::NbRows)
+        .def("clear",
+            [](TextRowsBuffer_Numpy& self) { self.Clear(); self.UpdateArrays(); })
+        .def_property_readonly("starts",
+            [](const TextRowsBuffer_Numpy& self) { return self.startsArray.View(); },
+            "Offset of the first byte of each row (int32)")
+        .def_property_readonly("ends",
+            [](const TextRowsBuffer_Numpy& self) { return self.endsArray.View(); },
+            "Offset after the last byte of each row (int32)")
+        .def_property_readonly("widths",
+            [](const TextRowsBuffer_Numpy& self) { return self.widthsArray.View(); },
+            "Logical width of each row (float32)")
+        .def_property_readonly("minxs",
+            [](const TextRowsBuffer_Numpy& self) { return self.minxsArray.View(); },
+            "Actual min x bound of each row (float32)")
+        .def_property_readonly("maxxs",
+            [](const TextRowsBuffer_Numpy& self) { return self.maxxsArray.View(); },
+            "Actual max x bound of each row (float32)")
+        ;
+
+    m.def("text_break_lines_into",
+        [](NVGcontext* ctx, std::string_view text, float breakRowWidth, TextRowsBuffer_Numpy& rows)
+        {
+            nvgcpp_TextBreakLinesInto(ctx, text.data(), text.data() + text.size(), breakRowWidth, &rows);
+            rows.UpdateArrays();
+        },
+        py::arg("ctx"), py::arg("text"), py::arg("break_row_width"), py::arg("rows"),
+        " Breaks the specified text into lines (same as text_break_lines), without limit on the number of rows.\n"
+        " The rows are written into a reusable buffer (whose previous content is replaced):\n"
+        " the rows text is not copied, and once the buffer is large enough, no allocation is done.");
+
+    py::class_<GlyphPositionsBuffer_Numpy>(m, "GlyphPositionsBuffer",
+        " The glyph positions of a text, filled by text_glyph_positions_into(), stored as numpy arrays which are reused between calls.\n"
+        " offsets, xs, minxs and maxxs return views of these arrays (without copy):\n"
+        " their values are overwritten by the next call to text_glyph_positions_into() (copy them to keep them).")
+        .def(py::init<>())
+        .def("nb_glyphs",
+            [](const GlyphPositionsBuffer_Numpy& self) { return (int)self.positions.size(); })
+        .def_property_readonly("offsets",
+            [](const GlyphPositionsBuffer_Numpy& self) { return self.offsetsArray.View(); },
+            "Offset of each glyph in the UTF-8 encoded text (int32)")
+        .def_property_readonly("xs",
+            [](const GlyphPositionsBuffer_Numpy& self) { return self.xsArray.View(); },
+            "The x-coordinate of the logical position of each glyph (float32)")
+        .def_property_readonly("minxs",
+            [](const GlyphPositionsBuffer_Numpy& self) { return self.minxsArray.View(); },
+            "The min x bound of the shape of each glyph (float32)")
+        .def_property_readonly("maxxs",
+            [](const GlyphPositionsBuffer_Numpy& self) { return self.maxxsArray.View(); },
+            "The max x bound of the shape of each glyph (float32)")
+        ;
+
+    m.def("text_glyph_positions_into",
+        [](NVGcontext* ctx, float x, float y, std::string_view text, GlyphPositionsBuffer_Numpy& glyphs)
+        {
+            nvgcpp_TextGlyphPositionsInto(ctx, x, y, text.data(), text.data() + text.size(), &glyphs.positions);
+            glyphs.UpdateArrays(text.data());
+        },
+        py::arg("ctx"), py::arg("x"), py::arg("y"), py::arg("text"), py::arg("glyphs"),
+        " Calculates the glyph x positions of the specified text (same as text_glyph_positions).\n"
+        " The positions are written into a reusable buffer (whose previous content is replaced):\n"
+        " once the buffer is large enough, no allocation is done.");
 }
@@ -0,0 +1,88 @@
+#include "nvg_cpp_batch.h"
+
+#include <cstring>
+
+
+namespace
+{
+    bool IsSameColor(const float* a, const float* b)
+    {
+        return memcmp(a, b, 4 * sizeof(float)) == 0;
+    }
+
+    void PaintPath(NVGcontext* ctx, const float* color, bool fill)
+    {
+        if (fill)
+        {
+            if (color != nullptr)
+                nvgFillColor(ctx, nvgRGBAf(color[0], color[1], color[2], color[3]));
+            nvgFill(ctx);
+        }
+        else
+        {
+            if (color != nullptr)
+                nvgStrokeColor(ctx, nvgRGBAf(color[0], color[1], color[2], color[3]));
+            nvgStroke(ctx);
+        }
+    }
+
+    // Adds the shapes to paths (addShape(i) adds the sub-path of the shape i),
+    // and paints one path per run of shapes which share the same color
+    template<typename AddShapeFunction>
+    void DrawShapes(NVGcontext* ctx, int nbShapes, const float* colors, bool fill, AddShapeFunction addShape)
+    {
+        if (nbShapes <= 0)
+            return;
+
+        int runStart = 0;
+        while (runStart < nbShapes)
+        {
+            int runEnd = nbShapes;
+            if (colors != nullptr)
+            {
+                runEnd = runStart + 1;
+                while (runEnd < nbShapes && IsSameColor(colors + 4 * runEnd, colors + 4 * runStart))
+                    ++runEnd;
+            }
+
+            nvgBeginPath(ctx);
+            for (int i = runStart; i < runEnd; ++i)
+                addShape(i);
+            PaintPath(ctx, colors != nullptr ? colors + 4 * runStart : nullptr, fill);
+
+            runStart = runEnd;
+        }
+    }
+}
+
+
+void nvgcpp_DrawPolylines(NVGcontext* ctx, const float* points, const int* offsets, int nbPolylines,
+                          const float* colors, bool closed, bool fill)
+{
+    DrawShapes(ctx, nbPolylines, colors, fill, [&](int i) {
+        int first = offsets[i], last = offsets[i + 1];
+        if (last - first < 2)
+            return;
+        nvgMoveTo(ctx, points[2 * first], points[2 * first + 1]);
+        for (int j = first + 1; j < last; ++j)
+            nvgLineTo(ctx, points[2 * j], points[2 * j + 1]);
+        if (closed)
+            nvgClosePath(ctx);
+    });
+}
+
+void nvgcpp_DrawCircles(NVGcontext* ctx, const float* centers, int nbCircles, const float* radii, float radius,
+                        const float* colors, bool fill)
+{
+    DrawShapes(ctx, nbCircles, colors, fill, [&](int i) {
+        nvgCircle(ctx, centers[2 * i], centers[2 * i + 1], radii != nullptr ? radii[i] : radius);
+    });
+}
+
+void nvgcpp_DrawRects(NVGcontext* ctx, const float* rects, int nbRects, const float* colors, bool fill)
+{
+    DrawShapes(ctx, nbRects, colors, fill, [&](int i) {
+        const float* r = rects + 4 * i;
+        nvgRect(ctx, r[0], r[1], r[2], r[3]);
+    });
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "nanovg.h"
+
+
+// Batched NanoVG drawing: each function below draws many shapes with a single call,
+// and issues the NanoVG calls in a single loop (this is used by the python bindings,
+// where one call per nvgMoveTo / nvgLineTo / nvgCircle would be too slow).
+//
+// All arrays are contiguous:
+//   - points and centers are interleaved: [x0, y0, x1, y1, ...]
+//   - rects are [x0, y0, w0, h0, x1, y1, w1, h1, ...]
+//   - colors are RGBA floats (one color per shape): [r0, g0, b0, a0, r1, g1, b1, a1, ...], or nullptr
+// If fill is true the shapes are filled, otherwise they are stroked.
+//
+// If colors is nullptr, all the shapes are added to a single path, which is painted once
+// with the current fill (or stroke) style.
+// Otherwise, consecutive shapes with the same color are grouped in one path: sorting the shapes by color
+// reduces the number of paths (and draw calls).
+//
+// These functions call nvgBeginPath: they replace the current path.
+
+
+// Draws nbPolylines polylines. The points of the polyline i are points[offsets[i]] to points[offsets[i+1] - 1],
+// i.e. offsets contains nbPolylines + 1 indices (in number of points, not floats), in increasing order.
+// If closed is true, a segment is added between the last and the first point of each polyline.
+void nvgcpp_DrawPolylines(NVGcontext* ctx, const float* points, const int* offsets, int nbPolylines,
+                          const float* colors, bool closed, bool fill);
+
+// Draws nbCircles circles. radii contains one radius per circle, or is nullptr (in which case radius is used).
+void nvgcpp_DrawCircles(NVGcontext* ctx, const float* centers, int nbCircles, const float* radii, float radius,
+                        const float* colors, bool fill);
+
+// Draws nbRects rectangles
+void nvgcpp_DrawRects(NVGcontext* ctx, const float* rects, int nbRects, const float* colors, bool fill);
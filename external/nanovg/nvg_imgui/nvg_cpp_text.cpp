@@ -29,11 +29,19 @@ Bounds nvgcpp_TextBoxBounds(NVGcontext* ctx, float x, float y, float breakRowWid
 
 std::vector<NVGglyphPosition> nvgcpp_TextGlyphPositions(NVGcontext* ctx, float x, float y, const std::string& text)
 {
-    std::vector<NVGglyphPosition> positions(text.size());
-    nvgTextGlyphPositions(ctx, x, y, text.c_str(), nullptr, positions.data(), (int)positions.size());
+    std::vector<NVGglyphPosition> positions;
+    nvgcpp_TextGlyphPositionsInto(ctx, x, y, text.data(), text.data() + text.size(), &positions);
     return positions;
 }
 
+void nvgcpp_TextGlyphPositionsInto(NVGcontext* ctx, float x, float y, const char* text, const char* end, std::vector<NVGglyphPosition>* positions)
+{
+    // There are at most as many glyphs as bytes (UTF-8): the vector is then shrunk to the actual number of glyphs
+    positions->resize((size_t)(end - text));
+    int nbGlyphs = positions->empty() ? 0 : nvgTextGlyphPositions(ctx, x, y, text, end, positions->data(), (int)positions->size());
+    positions->resize((size_t)nbGlyphs);
+}
+
 TextMetricsData nvgcpp_TextMetrics(NVGcontext* ctx)
 {
     TextMetricsData data;
@@ -47,25 +55,69 @@ void nvgcpp_TextLineHeight(NVGcontext* ctx, float lineHeight)
 }
 
 
-std::vector<NVGtextRowSimple> nvgcpp_TextBreakLines(NVGcontext* ctx, const std::string& text, float breakRowWidth)
+// Calls fn(const NVGtextRow&) for each row of the text.
+// nvgTextBreakLines is called on chunks of rows (each chunk starts where the previous one ended),
+// so that the number of rows is not limited, and no row array needs to be allocated.
+template<typename RowFunction>
+static void ForEachTextRow(NVGcontext* ctx, const char* text, const char* end, float breakRowWidth, RowFunction fn)
 {
-    constexpr int maxRows = 1000;
-    NVGtextRow rows[maxRows];
-    int nbRows = nvgTextBreakLines(ctx, text.c_str(), nullptr, breakRowWidth, rows, maxRows);
-    std::vector<NVGtextRowSimple> rowsVector;
-    rowsVector.reserve(nbRows);
-    for (int i = 0; i < nbRows; ++i)
+    constexpr int nbRowsPerChunk = 64;
+    NVGtextRow rows[nbRowsPerChunk];
+    const char* chunkStart = text;
+    while (chunkStart < end)
     {
-        NVGtextRowSimple row;
-        row.width = rows[i].width;
-        row.minx = rows[i].minx;
-        row.maxx = rows[i].maxx;
-        row.row_text = std::string(rows[i].start, rows[i].end);
-        rowsVector.push_back(row);
+        int nbRows = nvgTextBreakLines(ctx, chunkStart, end, breakRowWidth, rows, nbRowsPerChunk);
+        for (int i = 0; i < nbRows; ++i)
+            fn(rows[i]);
+        if (nbRows < nbRowsPerChunk)
+            break;
+        const char* next = rows[nbRows - 1].next;
+        if (next <= chunkStart) // Should not happen: protect against an infinite loop
+            break;
+        // nvgTextBreakLines treats a '\r' which follows a '\n' (and vice versa) as a space, so that "\r\n" is one newline.
+        // When the last row of the chunk ends with a newline, these characters would instead start extra empty rows.
+        auto isNewLine = [](char c) { return c == '\r' || c == '\n'; };
+        while (next < end && isNewLine(next[-1]) && isNewLine(*next) && *next != next[-1])
+            ++next;
+        chunkStart = next;
     }
+}
+
+std::vector<NVGtextRowSimple> nvgcpp_TextBreakLines(NVGcontext* ctx, const std::string& text, float breakRowWidth)
+{
+    std::vector<NVGtextRowSimple> rowsVector;
+    ForEachTextRow(ctx, text.data(), text.data() + text.size(), breakRowWidth, [&](const NVGtextRow& row) {
+        NVGtextRowSimple rowSimple;
+        rowSimple.width = row.width;
+        rowSimple.minx = row.minx;
+        rowSimple.maxx = row.maxx;
+        rowSimple.row_text = std::string(row.start, row.end);
+        rowsVector.push_back(std::move(rowSimple));
+    });
     return rowsVector;
 }
 
+void TextRowsBuffer::Clear()
+{
+    starts.clear();
+    ends.clear();
+    widths.clear();
+    minxs.clear();
+    maxxs.clear();
+}
+
+void nvgcpp_TextBreakLinesInto(NVGcontext* ctx, const char* text, const char* end, float breakRowWidth, TextRowsBuffer* rows)
+{
+    rows->Clear();
+    ForEachTextRow(ctx, text, end, breakRowWidth, [&](const NVGtextRow& row) {
+        rows->starts.push_back((int)(row.start - text));
+        rows->ends.push_back((int)(row.end - text));
+        rows->widths.push_back(row.width);
+        rows->minxs.push_back(row.minx);
+        rows->maxxs.push_back(row.maxx);
+    });
+}
+
 void nvgcpp_TextAlign(NVGcontext* ctx, int align)
 {
     nvgTextAlign(ctx, align);
@@ -35,6 +35,9 @@ Bounds nvgcpp_TextBoxBounds(NVGcontext* ctx, float x, float y, float breakRowWid
 // Measured values are returned in local coordinate space.
 std::vector<NVGglyphPosition> nvgcpp_TextGlyphPositions(NVGcontext* ctx, float x, float y, const std::string& text);
 
+// Same as nvgcpp_TextGlyphPositions, but writes into a caller provided vector (whose capacity is reused)
+void nvgcpp_TextGlyphPositionsInto(NVGcontext* ctx, float x, float y, const char* text, const char* end, std::vector<NVGglyphPosition>* positions);
+
 
 struct TextMetricsData
 {
@@ -60,6 +63,25 @@ struct NVGtextRowSimple {
 // Words longer than the max width are split at nearest character (i.e. no hyphenation).
 std::vector<NVGtextRowSimple> nvgcpp_TextBreakLines(NVGcontext* ctx, const std::string& text, float breakRowWidth);
 
+
+// TextRowsBuffer: the rows of a text broken into lines, stored as arrays which are reused between calls
+// (once they are large enough, breaking lines does not allocate).
+// The rows are given as byte offsets in the text (which is UTF-8), instead of copies of the rows text.
+struct TextRowsBuffer
+{
+    std::vector<int> starts;        // Offset of the first byte of each row
+    std::vector<int> ends;          // Offset after the last byte of each row
+    std::vector<float> widths;      // Logical width of each row.
+    std::vector<float> minxs, maxxs;// Actual bounds of each row. Logical with and bounds can differ because of kerning and some parts over extending.
+
+    int NbRows() const { return (int)starts.size(); }
+    void Clear();
+};
+
+// Breaks the specified text into lines (same as nvgcpp_TextBreakLines), without limit on the number of rows.
+// The previous content of rows is replaced, but its capacity is reused.
+void nvgcpp_TextBreakLinesInto(NVGcontext* ctx, const char* text, const char* end, float breakRowWidth, TextRowsBuffer* rows);
+
 // Sets the text align of current text style, see NVGalign for options.
 void nvgcpp_TextAlign(NVGcontext* ctx, int align);
 
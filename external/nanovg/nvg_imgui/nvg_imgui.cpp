@@ -4,6 +4,11 @@
 #include "nanovg.h"
 #include "imgui.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #ifdef HAS_NVG_OPENGL
     #include "hello_imgui/hello_imgui_include_opengl.h"
 
@@ -28,43 +33,45 @@
 #ifdef HAS_NVG_OPENGL
 namespace NvgImgui
 {
-    struct NvgFramebuffer::PImpl
+    // A framebuffer allocated by the renderer backend
+    // (its size is the capacity of the NvgFramebuffer which uses it)
+    struct FramebufferAllocation
     {
+        NVGcontext *vg = nullptr;
         NVGLUframebuffer *fb = nullptr;
-        GLint defaultViewport[4];  // To store the default viewport dimensions
-        NvgFramebuffer *_parent = nullptr;
-
-        PImpl(NvgFramebuffer *parent) : _parent(parent)
-        {
-            AcquireResource();
-        }
-
-        ~PImpl()
-        {
-            ReleaseResource();
-        }
+        int Width = 0, Height = 0;
+        int NvgImageFlags = 0;
 
-        void AcquireResource()
+        FramebufferAllocation(NVGcontext *vg_, int width, int height, int nvgImageFlags)
+            : vg(vg_), Width(width), Height(height), NvgImageFlags(nvgImageFlags)
         {
-            if (_parent->vg == nullptr)
-                return;
-            fb = nvgluCreateFramebuffer(_parent->vg, _parent->Width, _parent->Height, _parent->NvgImageFlags);
+            fb = nvgluCreateFramebuffer(vg, width, height, nvgImageFlags);
             IM_ASSERT(fb && "Failed to create NVGLU framebuffer");
-            _parent->TextureId = (ImTextureID) (intptr_t) fb->texture;
         }
 
-        void ReleaseResource()
+        ~FramebufferAllocation()
         {
             if (fb)
-            {
                 nvgluDeleteFramebuffer(fb);
-                fb = nullptr;
-            }
         }
 
+        ImTextureID TextureId() const { return (ImTextureID) (intptr_t) fb->texture; }
+    };
+
+    // With OpenGL, a framebuffer may render into a part of a larger allocation (see Bind)
+    static constexpr bool CanUseLargerAllocation = true;
+
+    struct NvgFramebuffer::PImpl
+    {
+        std::unique_ptr<FramebufferAllocation> allocation;
+        GLint defaultViewport[4];  // To store the default viewport dimensions
+        NvgFramebuffer *_parent = nullptr;
+
+        PImpl(NvgFramebuffer *parent) : _parent(parent) {}
+
         void Bind()
         {
-            nvgluBindFramebuffer(fb);
+            nvgluBindFramebuffer(allocation->fb);
             glGetIntegerv(GL_VIEWPORT, defaultViewport);
             glViewport(0, 0, _parent->Width, _parent->Height);
         }
@@ -106,43 +113,43 @@ namespace NvgImgui
 #ifdef HAS_NVG_METAL
 namespace NvgImgui
 {
-    struct NvgFramebuffer::PImpl
+    // A framebuffer allocated by the renderer backend
+    struct FramebufferAllocation
     {
+        NVGcontext *vg = nullptr;
         MNVGframebuffer *fb = nullptr;
-        // GLint defaultViewport[4];  // To store the default viewport dimensions
-        NvgFramebuffer *_parent = nullptr;
-
-        PImpl(NvgFramebuffer *parent) : _parent(parent)
-        {
-            AcquireResource();
-        }
-
-        ~PImpl()
-        {
-            ReleaseResource();
-        }
+        int Width = 0, Height = 0;
+        int NvgImageFlags = 0;
 
-        void AcquireResource()
+        FramebufferAllocation(NVGcontext *vg_, int width, int height, int nvgImageFlags)
+            : vg(vg_), Width(width), Height(height), NvgImageFlags(nvgImageFlags)
         {
-            if (_parent->vg == nullptr)
-                return;
-            fb = mnvgCreateFramebuffer(_parent->vg, _parent->Width, _parent->Height, _parent->NvgImageFlags);
+            fb = mnvgCreateFramebuffer(vg, width, height, nvgImageFlags);
             IM_ASSERT(fb && "Failed to create NVGLU framebuffer");
-            _parent->TextureId = mnvgImageHandle(_parent->vg, fb->image);
         }
 
-        void ReleaseResource()
+        ~FramebufferAllocation()
         {
             if (fb)
-            {
                 mnvgDeleteFramebuffer(fb);
-                fb = nullptr;
-            }
         }
 
+        ImTextureID TextureId() const { return mnvgImageHandle(vg, fb->image); }
+    };
+
+    // With Metal, the drawing covers the whole render target: the allocation size must match the framebuffer size
+    static constexpr bool CanUseLargerAllocation = false;
+
+    struct NvgFramebuffer::PImpl
+    {
+        std::unique_ptr<FramebufferAllocation> allocation;
+        NvgFramebuffer *_parent = nullptr;
+
+        PImpl(NvgFramebuffer *parent) : _parent(parent) {}
+
         void Bind()
         {
-            mnvgBindFramebuffer(fb);
+            mnvgBindFramebuffer(allocation->fb);
         }
 
         void Unbind()
@@ -166,17 +173,144 @@ namespace NvgImgui
 
 namespace NvgImgui
 {
-    NvgFramebuffer::NvgFramebuffer(NVGcontext* vg, int width, int height, int nvgImageFlags) // See NVGimageFlags
-        : vg(vg), Width(width), Height(height), NvgImageFlags(nvgImageFlags)
+    using FramebufferAllocations = std::vector<std::unique_ptr<FramebufferAllocation>>;
+
+    // An allocation can be used for a framebuffer if it is large enough, but not more than 4 times too large
+    static bool CanUseAllocation(const FramebufferAllocation& allocation, NVGcontext* vg, int width, int height, int nvgImageFlags)
+    {
+        if (allocation.vg != vg || allocation.NvgImageFlags != nvgImageFlags)
+            return false;
+        if (!CanUseLargerAllocation)
+            return allocation.Width == width && allocation.Height == height;
+        bool isLargeEnough = allocation.Width >= width && allocation.Height >= height;
+        bool isNotTooLarge = (int64_t)allocation.Width * allocation.Height <= 4 * (int64_t)width * height;
+        return isLargeEnough && isNotTooLarge;
+    }
+
+    // Takes the smallest pooled allocation which can be used (or returns nullptr)
+    static std::unique_ptr<FramebufferAllocation> TakePooledAllocation(
+        FramebufferAllocations& pooled, NVGcontext* vg, int width, int height, int nvgImageFlags)
+    {
+        auto best = pooled.end();
+        for (auto it = pooled.begin(); it != pooled.end(); ++it)
+        {
+            if (!CanUseAllocation(**it, vg, width, height, nvgImageFlags))
+                continue;
+            if (best == pooled.end() || (*it)->Width * (*it)->Height < (*best)->Width * (*best)->Height)
+                best = it;
+        }
+        if (best == pooled.end())
+            return nullptr;
+        std::unique_ptr<FramebufferAllocation> r = std::move(*best);
+        pooled.erase(best);
+        return r;
+    }
+
+
+    struct NvgFramebufferPool::PImpl
+    {
+        int maxPooledAllocations = 8;
+        FramebufferAllocations allocations;  // Oldest first
+
+        void Give(std::unique_ptr<FramebufferAllocation> allocation)
+        {
+            allocations.push_back(std::move(allocation));
+            while ((int)allocations.size() > maxPooledAllocations)
+                allocations.erase(allocations.begin());
+        }
+    };
+
+    NvgFramebufferPool::NvgFramebufferPool(int maxPooledAllocations)
+    {
+        pImpl = new PImpl();
+        pImpl->maxPooledAllocations = maxPooledAllocations;
+    }
+
+    NvgFramebufferPool::~NvgFramebufferPool() { delete pImpl; }
+
+    int NvgFramebufferPool::NbPooledAllocations() const { return (int)pImpl->allocations.size(); }
+    void NvgFramebufferPool::Clear() { pImpl->allocations.clear(); }
+
+
+    NvgFramebuffer::NvgFramebuffer(NVGcontext* vg, int width, int height, int nvgImageFlags, NvgFramebufferPool* pool) // See NVGimageFlags
+        : vg(vg), Width(width), Height(height), NvgImageFlags(nvgImageFlags), pool(pool)
     {
         pImpl = new PImpl(this);
+        SetAllocation(width, height);
     }
 
-    NvgFramebuffer::~NvgFramebuffer() { delete pImpl; }
+    NvgFramebuffer::~NvgFramebuffer()
+    {
+        ReleaseAllocation();
+        delete pImpl;
+    }
 
     void NvgFramebuffer::Bind() { pImpl->Bind(); }
     void NvgFramebuffer::Unbind() { pImpl->Unbind(); }
 
+    void NvgFramebuffer::Resize(int width, int height)
+    {
+        width = std::max(width, 1);
+        height = std::max(height, 1);
+        if (width == Width && height == Height)
+            return;
+        Width = width;
+        Height = height;
+        Invalidate();
+        if (vg == nullptr)
+            return;
+
+        const auto& allocation = pImpl->allocation;
+        if (allocation && CanUseAllocation(*allocation, vg, width, height, NvgImageFlags))
+            return;
+
+        // The capacity grows by 1.5x at least, so that a drag-resize does not reallocate at each frame
+        int capacityWidth = width, capacityHeight = height;
+        if (CanUseLargerAllocation && allocation)
+        {
+            if (width > allocation->Width)
+                capacityWidth = std::max(width, allocation->Width * 3 / 2);
+            if (height > allocation->Height)
+                capacityHeight = std::max(height, allocation->Height * 3 / 2);
+        }
+        ReleaseAllocation();
+        SetAllocation(capacityWidth, capacityHeight);
+    }
+
+    ImVec2 NvgFramebuffer::TextureUv1() const
+    {
+        const auto& allocation = pImpl->allocation;
+        if (!allocation)
+            return ImVec2(1.f, 1.f);
+        return ImVec2((float)Width / (float)allocation->Width, (float)Height / (float)allocation->Height);
+    }
+
+    void NvgFramebuffer::Invalidate()
+    {
+        renderedContentVersion.reset();
+    }
+
+    void NvgFramebuffer::SetAllocation(int capacityWidth, int capacityHeight)
+    {
+        if (vg == nullptr)
+            return;
+        auto& allocation = pImpl->allocation;
+        if (pool)
+            allocation = TakePooledAllocation(pool->pImpl->allocations, vg, capacityWidth, capacityHeight, NvgImageFlags);
+        if (!allocation)
+            allocation = std::make_unique<FramebufferAllocation>(vg, capacityWidth, capacityHeight, NvgImageFlags);
+        TextureId = allocation->TextureId();
+        CapacityWidth = allocation->Width;
+        CapacityHeight = allocation->Height;
+    }
+
+    void NvgFramebuffer::ReleaseAllocation()
+    {
+        if (pool && pImpl->allocation)
+            pool->pImpl->Give(std::move(pImpl->allocation));
+        pImpl->allocation.reset();
+    }
+
 
     void RenderNvgToBackground(NVGcontext* vg, NvgDrawingFunction nvgDrawingFunction, ImVec4 clearColor)
     {
@@ -199,6 +333,7 @@ namespace NvgImgui
 
     void RenderNvgToFrameBuffer(NVGcontext* vg, NvgFramebuffer& texture, NvgDrawingFunction drawFunc, ImVec4 clearColor)
     {
+        texture.Invalidate();
         texture.Bind();
         if (clearColor.w > 0.f)
             FillClearColor(vg, clearColor);
@@ -231,6 +366,16 @@ namespace NvgImgui
         texture.Unbind();
     }
 
+    bool RenderNvgToFrameBufferIfChanged(
+        NVGcontext* vg, NvgFramebuffer& texture, NvgDrawingFunction drawFunc, int64_t contentVersion, ImVec4 clearColor)
+    {
+        if (texture.renderedContentVersion == contentVersion)
+            return false;
+        RenderNvgToFrameBuffer(vg, texture, drawFunc, clearColor);
+        texture.renderedContentVersion = contentVersion;
+        return true;
+    }
+
 
     // Context creation for HelloImGui
     NVGcontext* CreateNvgContext_HelloImGui(int flags)
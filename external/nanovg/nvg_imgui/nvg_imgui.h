@@ -10,8 +10,10 @@
 
 
 #include "imgui.h"
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include "nanovg.h"
 
 struct NVGcontext;
@@ -66,6 +68,12 @@ namespace NvgImgui
     //
     ///////////////////////////////////////////////////////////////////////////
 
+    // NvgDrawingFunction: a function that can be used to draw to a NanoVG context
+    // it receives the NanoVG context, and the width and height of the rendering
+    using NvgDrawingFunction = std::function<void(NVGcontext* vg, float width, float height)>;
+
+    class NvgFramebufferPool;
+
     // NvgFramebuffer: a framebuffer that can be used by NanoVG + ImGui
     // Internally stored inside the renderer backend (e.g. OpenGL)
     // Note: this class can be instantiated only after a valid renderer backend (OpenGL) has been created
@@ -76,13 +84,18 @@ namespace NvgImgui
         int Width = 0, Height = 0;
         int NvgImageFlags = 0;
         ImTextureID TextureId = {};
+        // Size of the texture, which may be larger than Width x Height after Resize() (OpenGL only)
+        int CapacityWidth = 0, CapacityHeight = 0;
 
         // Warning: this constructor can be called only after a valid renderer backend (OpenGL) has been created
         // (will call Init())
+        // If a pool is given, the allocation may be taken from it, and will be given back to it
+        // (in python, the framebuffer keeps the pool alive)
         NvgFramebuffer(
             NVGcontext *vg,
             int width, int height,
-            int nvgImageFlags
+            int nvgImageFlags,
+            NvgFramebufferPool* pool = nullptr
             ); // See NVGimageFlags
 
         // Warning: this destructor should be called when a valid render backend (e.g. OpenGL) is still active
@@ -95,10 +108,56 @@ namespace NvgImgui
         // Restore the previous render target
         void Unbind();
 
+        // Resize: changes the size of the framebuffer, and reuses its texture when the new size fits in it.
+        // Otherwise, the capacity grows by 1.5x at least, so that a drag-resize does not reallocate at each frame
+        // (and a texture more than 4 times too large is reallocated).
+        // Note: TextureId may change. Display the texture with uv1 = TextureUv1().
+        void Resize(int width, int height);
+
+        // The uv1 coordinates to use when displaying TextureId with ImGui::Image
+        // (the texture may be larger than Width x Height)
+        ImVec2 TextureUv1() const;
+
+        // Invalidate: the next call to RenderNvgToFrameBufferIfChanged will redraw the framebuffer
+        // (Resize() also invalidates it)
+        void Invalidate();
+
     private:
+        void SetAllocation(int capacityWidth, int capacityHeight);
+        void ReleaseAllocation();
+
+        // Version of the content drawn by RenderNvgToFrameBufferIfChanged
+        std::optional<int64_t> renderedContentVersion;
+        friend bool RenderNvgToFrameBufferIfChanged(NVGcontext*, NvgFramebuffer&, NvgDrawingFunction, int64_t, ImVec4);
+
         // PImpl that contains the actual implementation of the framebuffer, depending on the rendering backend
         struct PImpl;
         PImpl* pImpl = nullptr;
+        NvgFramebufferPool* pool = nullptr;
+    };
+
+
+    // NvgFramebufferPool: keeps the textures of destroyed or resized NvgFramebuffers, so that they can be reused
+    // by other framebuffers (e.g. several resizable NanoVG panels), instead of being deleted and reallocated.
+    // Warning: the pool must outlive its framebuffers, and be destroyed when the renderer backend
+    // and the NVGcontext are still valid
+    class NvgFramebufferPool
+    {
+    public:
+        // At most maxPooledAllocations unused textures are kept (the oldest ones are deleted first)
+        NvgFramebufferPool(int maxPooledAllocations = 8);
+        ~NvgFramebufferPool();
+
+        // Number of unused textures in the pool
+        int NbPooledAllocations() const;
+
+        // Deletes the unused textures
+        void Clear();
+
+    private:
+        friend class NvgFramebuffer;
+        struct PImpl;
+        PImpl* pImpl = nullptr;
     };
 
 
@@ -109,10 +168,6 @@ namespace NvgImgui
     //
     ///////////////////////////////////////////////////////////////////////////
 
-    // NvgDrawingFunction: a function that can be used to draw to a NanoVG context
-    // it receives the NanoVG context, and the width and height of the rendering
-    using NvgDrawingFunction = std::function<void(NVGcontext* vg, float width, float height)>;
-
     // Render the given drawing function to the background of the application
     // (i.e. the main viewport)
     // If clearColor.w > 0.f, the background will be cleared with this color
@@ -124,6 +179,7 @@ namespace NvgImgui
 
     // Render the given drawing function to the given framebuffer
     // If clearColor.w > 0.f, the background will be cleared with this color
+    // (the framebuffer is invalidated: the next call to RenderNvgToFrameBufferIfChanged will redraw it)
     void RenderNvgToFrameBuffer(
         NVGcontext* vg,
         NvgFramebuffer& texture,
@@ -131,6 +187,20 @@ namespace NvgImgui
         ImVec4 clearColor = ImVec4(0.f, 0.f, 0.f, 1.f)
         );
 
+    // Render the given drawing function to the given framebuffer, only if contentVersion changed
+    // since the last call (or if the framebuffer was resized or invalidated).
+    // Otherwise, the framebuffer texture is left untouched: a static drawing costs nothing.
+    // contentVersion is any value (counter, hash...) which changes when the inputs of the drawing change
+    // (it is signed, so that a python hash() can be used).
+    // Returns true if the drawing function was called.
+    bool RenderNvgToFrameBufferIfChanged(
+        NVGcontext* vg,
+        NvgFramebuffer& texture,
+        NvgDrawingFunction drawFunc,
+        int64_t contentVersion,
+        ImVec4 clearColor = ImVec4(0.f, 0.f, 0.f, 1.f)
+        );
+
 }
 
 #endif // #ifdef IMGUI_BUNDLE_WITH_NANOVG
@@ -30,3 +30,38 @@ def test_imgui_context_creation():
     ctx = imgui.create_context()
     assert ctx is not None
     imgui.destroy_context(ctx)
+
+
+def test_text_editor_change_tracker_detects_set_text():
+    if sys.platform == "win32":
+        return
+    from imgui_bundle import imgui, imgui_color_text_edit as ed
+
+    ctx = imgui.create_context()
+    io = imgui.get_io()
+    io.display_size = imgui.ImVec2(800.0, 600.0)
+    io.fonts.build()
+
+    editor = ed.TextEditor()
+    editor.set_text("a\nb")
+    tracker = ed.TextEditorChangeTracker(editor)
+
+    def render_frame():
+        imgui.new_frame()
+        imgui.begin("Editor")
+        editor.render("##editor")
+        imgui.end()
+        imgui.render()
+        assert not tracker.update()
+
+    # Render() clears the flag set by SetText(): a later SetText() with the same number of lines
+    # (and an undo index which stays at 0) is detected by the hash of the text
+    render_frame()
+    editor.set_text("a\nc")
+    assert tracker.update()
+    deltas = tracker.get_deltas_since(0)
+    assert len(deltas) == 1
+    assert deltas[0].start_line == 1 and deltas[0].end_line == 2
+    assert deltas[0].inserted_lines == ["c"]
+    render_frame()
+    imgui.destroy_context(ctx)